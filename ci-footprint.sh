@@ -0,0 +1,90 @@
+#!/bin/bash
+# Builds the example for a reference board and reports how much flash and RAM
+# each printFourRegXXX() function and each name table costs.
+# Fails if the library as a whole grows past the limits in ci-footprint-limit.txt,
+# or if that file doesn't have them.
+# With --update it instead writes the measured totals plus MARGIN percent into
+# that file, which is how the limits are set.
+#
+# usage:  ./ci-footprint.sh [--update] [board]
+UPDATE=0
+if [[ "$1" == "--update" ]]; then
+    UPDATE=1
+    shift
+fi
+BOARD=${1:-adafruit_metro_m4}
+LIMITS=ci-footprint-limit.txt
+MARGIN=10
+BUILD=$(mktemp -d)
+trap 'rm -rf "$BUILD"' EXIT
+
+echo ============================================================ footprint $BOARD
+pio ci examples/FourRegsExample --lib src --board $BOARD --keep-build-dir --build-dir "$BUILD" > "$BUILD/build.log" 2>&1 || {
+    cat "$BUILD/build.log"
+    exit 1
+}
+ELF=$(find "$BUILD" -name firmware.elf | head -1)
+if [[ -z "$ELF" ]]; then
+    echo "couldn't find firmware.elf"
+    exit 1
+fi
+NM=$(find ~/.platformio/packages -name arm-none-eabi-nm -type f | head -1)
+NM=${NM:-arm-none-eabi-nm}
+
+# text and rodata only cost flash, data costs both, bss only costs RAM
+# (string literals live in anonymous .rodata.str sections, so are not attributed)
+"$NM" --print-size --size-sort --radix=d --demangle "$ELF" \
+| grep -E 'printFourReg|FourRegs' \
+| awk -v limits="$LIMITS" -v update=$UPDATE -v margin=$MARGIN -v board=$BOARD '
+    BEGIN {
+        while ((getline line < limits) > 0) {
+            split(line, f, /[ \t]+/)
+            if (f[1] == "flash") { maxFlash = f[2] }
+            if (f[1] == "ram") { maxRAM = f[2] }
+        }
+    }
+    {
+        size = $2 + 0
+        type = toupper($3)
+        name = $4
+        for (i = 5; i <= NF; i++) { name = name " " $i }
+        sub(/\(.*/, "", name)
+        flash = 0; ram = 0
+        if (type == "T" || type == "R" || type == "W") { flash = size }
+        if (type == "D") { flash = size; ram = size }
+        if (type == "B") { ram = size }
+        FLASH[name] += flash
+        RAM[name] += ram
+        totalFlash += flash
+        totalRAM += ram
+    }
+    END {
+        printf "%-40s %8s %8s\n", "symbol", "flash", "ram"
+        for (name in FLASH) {
+            printf "%-40s %8d %8d\n", name, FLASH[name], RAM[name] | "sort"
+        }
+        close("sort")
+        printf "%-40s %8d %8d\n", "TOTAL", totalFlash, totalRAM
+        if (update) {
+            printf "# limits for ci-footprint.sh, in bytes\n" > limits
+            printf "# measured on %s: flash %d ram %d, plus %d%%\n", board, totalFlash, totalRAM, margin > limits
+            printf "flash   %d\n", int(totalFlash * (100 + margin) / 100) > limits
+            printf "ram     %d\n", int(totalRAM * (100 + margin) / 100) > limits
+            printf "wrote %s\n", limits
+            exit 0
+        }
+        status = 0
+        if (maxFlash == "" || maxRAM == "") {
+            printf "FAILED: no flash/ram limits in %s, run with --update to measure them\n", limits
+            status = 1
+        }
+        if (maxFlash != "" && totalFlash > maxFlash + 0) {
+            printf "FAILED: flash %d is over the limit of %d\n", totalFlash, maxFlash
+            status = 1
+        }
+        if (maxRAM != "" && totalRAM > maxRAM + 0) {
+            printf "FAILED: RAM %d is over the limit of %d\n", totalRAM, maxRAM
+            status = 1
+        }
+        exit status
+    }'
@@ -52,10 +52,16 @@ static const char* FourRegs__empty = "";
 #define PRINTHEX(x) do { opts.print.print("0x"); opts.print.print(x, HEX); } while(0)
 #define PRINTSCALE(x) (opts.print.print(1 << (x)))
 #define PRINTNL() opts.print.println(FourRegs__empty)
+#define PRINTRAW(x) do { if (opts.formatter) { opts.formatter->raw(x); } } while(0)
 #define PRINTPAD2(x) do { if (x < 10) { opts.print.print("0"); } opts.print.print(x, DEC); } while(0)
 #define COPYVOL(dst,src) do { memcpy((void*)(&(dst)), (void*)(&(src)), sizeof(dst)); } while(0)
 #define READSCS(val,name) ( (val & (name##_Msk)) >> (name##_Pos) )
 void printFourRegSERCOM_pinhint(FourRegOptions &opts, const char* pmux);
+void fourRegsSERCOM_loadPads();
+uint8_t fourRegsSERCOM_padRole(const char* pmux);
+const char* fourRegsPORT_func(uint8_t gid, uint8_t pid, uint8_t sel);
+uint8_t fourRegsPORT_pmux(uint8_t gid, uint8_t pid);
+uint8_t fourRegsPORT_extint(uint8_t gid, uint8_t pid);
 
 
 // When using platformio.org, peripheral details can be found in
@@ -72,6 +78,367 @@ void printFourReg_QOS(FourRegOptions &opts, uint8_t qos) {
 }
 
 
+// Frequency of external crystals/clocks isn't discoverable from the registers.
+// Boards which use them can define these (in Hz) in their build flags.
+#ifndef FOUR_REGS_XOSC0_HZ
+#define FOUR_REGS_XOSC0_HZ 0
+#endif
+#ifndef FOUR_REGS_XOSC1_HZ
+#define FOUR_REGS_XOSC1_HZ 0
+#endif
+#ifndef FOUR_REGS_GCLKIN_HZ
+#define FOUR_REGS_GCLKIN_HZ 0
+#endif
+
+// The following return 0 when the frequency can't be known.
+uint32_t fourRegsGeneratorHz(uint8_t genid);
+uint32_t fourRegsChannelHz(uint8_t pchid);
+
+// guards against clock loops, such as a DPLL referenced by its own output
+static uint8_t FourRegsHz_depth = 0;
+
+uint32_t fourRegsDFLLHz() {
+    if (!OSCCTRL->DFLLCTRLA.bit.ENABLE) {
+        return 0;
+    }
+    if (!OSCCTRL->DFLLCTRLB.bit.MODE || OSCCTRL->DFLLCTRLB.bit.USBCRM) {
+        return 48000000;
+    }
+    return fourRegsChannelHz(0) * OSCCTRL->DFLLMUL.bit.MUL;
+}
+
+uint32_t fourRegsDPLLHz(uint8_t dpllid) {
+    if (!OSCCTRL->Dpll[dpllid].DPLLCTRLA.bit.ENABLE) {
+        return 0;
+    }
+    uint32_t ref = 0;
+    uint32_t div = 2 * (OSCCTRL->Dpll[dpllid].DPLLCTRLB.bit.DIV + 1);
+    switch (OSCCTRL->Dpll[dpllid].DPLLCTRLB.bit.REFCLK) {
+        case 0x0: ref = fourRegsChannelHz(1 + dpllid); break;
+        case 0x1: ref = 32768; break;
+        case 0x2: ref = FOUR_REGS_XOSC0_HZ / div; break;
+        case 0x3: ref = FOUR_REGS_XOSC1_HZ / div; break;
+    }
+    // out = REFCLK * (LDR+1+(LDRFRAC/32))
+    uint32_t ratio = 32 * (OSCCTRL->Dpll[dpllid].DPLLRATIO.bit.LDR + 1) + OSCCTRL->Dpll[dpllid].DPLLRATIO.bit.LDRFRAC;
+    return ((uint64_t) ref * ratio) / 32;
+}
+
+// table 14-4 (datasheet rev E)
+uint32_t fourRegsSourceHz(uint8_t src) {
+    switch (src) {
+        case 0x0: return OSCCTRL->XOSCCTRL[0].bit.ENABLE ? FOUR_REGS_XOSC0_HZ : 0;
+        case 0x1: return OSCCTRL->XOSCCTRL[1].bit.ENABLE ? FOUR_REGS_XOSC1_HZ : 0;
+        case 0x2: return FOUR_REGS_GCLKIN_HZ;
+        case 0x3: return fourRegsGeneratorHz(1);
+        case 0x4: return 32768;
+        case 0x5: return OSC32KCTRL->XOSC32K.bit.ENABLE ? 32768 : 0;
+        case 0x6: return fourRegsDFLLHz();
+        case 0x7: return fourRegsDPLLHz(0);
+        case 0x8: return fourRegsDPLLHz(1);
+    }
+    return 0;
+}
+
+uint32_t fourRegsGeneratorHz(uint8_t genid) {
+    GCLK_GENCTRL_Type gen;
+    while (GCLK->SYNCBUSY.reg) {}
+    COPYVOL(gen, GCLK->GENCTRL[genid]);
+    if (!gen.bit.GENEN || FourRegsHz_depth > 4) {
+        return 0;
+    }
+    FourRegsHz_depth++;
+    uint32_t hz = fourRegsSourceHz(gen.bit.SRC);
+    FourRegsHz_depth--;
+    if (gen.bit.DIVSEL) {
+        return hz >> (gen.bit.DIV + 1);
+    }
+    return (gen.bit.DIV > 1) ? (hz / gen.bit.DIV) : hz;
+}
+
+uint32_t fourRegsChannelHz(uint8_t pchid) {
+    GCLK_PCHCTRL_Type pch;
+    COPYVOL(pch, GCLK->PCHCTRL[pchid]);
+    if (!pch.bit.CHEN) {
+        return 0;
+    }
+    return fourRegsGeneratorHz(pch.bit.GEN);
+}
+
+void printFourReg_HZ(FourRegOptions &opts, uint32_t hz) {
+    if (hz) {
+        opts.print.print(hz);
+    } else {
+        opts.print.print("?");
+    }
+}
+
+// GCLK peripheral channel for each SERCOM, TC, and TCC (table 14-9 datasheet rev E)
+static const uint8_t FourRegsSERCOM_PCHs[8] = { 7, 8, 23, 24, 34, 35, 36, 37 };
+static const uint8_t FourRegsTC_PCHs[8] = { 9, 9, 26, 26, 30, 30, 39, 39 };
+static const uint8_t FourRegsTCC_PCHs[5] = { 25, 25, 29, 29, 38 };
+static const uint16_t FourRegsTC_PRESCALERs[8] = { 1, 2, 4, 8, 16, 64, 256, 1024 };
+
+Sercom* fourRegsSERCOM(uint8_t idx) {
+    switch (idx) {
+        case 0: return SERCOM0;
+        case 1: return SERCOM1;
+        case 2: return SERCOM2;
+        case 3: return SERCOM3;
+        case 4: return SERCOM4;
+        case 5: return SERCOM5;
+#ifdef SERCOM6
+        case 6: return SERCOM6;
+#endif
+#ifdef SERCOM7
+        case 7: return SERCOM7;
+#endif
+    }
+    return NULL;
+}
+
+Tc* fourRegsTC(uint8_t idx) {
+    switch (idx) {
+        case 0: return TC0;
+        case 1: return TC1;
+        case 2: return TC2;
+        case 3: return TC3;
+#ifdef TC4
+        case 4: return TC4;
+#endif
+#ifdef TC5
+        case 5: return TC5;
+#endif
+#ifdef TC6
+        case 6: return TC6;
+#endif
+#ifdef TC7
+        case 7: return TC7;
+#endif
+    }
+    return NULL;
+}
+
+Tcc* fourRegsTCC(uint8_t idx) {
+    switch (idx) {
+        case 0: return TCC0;
+        case 1: return TCC1;
+        case 2: return TCC2;
+#ifdef TCC3
+        case 3: return TCC3;
+#endif
+#ifdef TCC4
+        case 4: return TCC4;
+#endif
+    }
+    return NULL;
+}
+
+// characters per second (the rate of RX/TX DMA triggers) of a SERCOM
+float fourRegsSERCOMCharHz(uint8_t idx) {
+    Sercom* sercom = fourRegsSERCOM(idx);
+    if (!sercom || !sercom->USART.CTRLA.bit.ENABLE) {
+        return 0;
+    }
+    float ref = fourRegsChannelHz(FourRegsSERCOM_PCHs[idx]);
+    switch (sercom->USART.CTRLA.bit.MODE) {
+        case 0x1: {
+            // USART with internal clock
+            uint8_t sampr = sercom->USART.CTRLA.bit.SAMPR;
+            uint8_t samples = (sampr < 2) ? 16 : ((sampr < 4) ? 8 : 3);
+            float baud;
+            if (sampr == 1 || sampr == 3) {
+                float div = sercom->USART.BAUD.FRAC.BAUD + sercom->USART.BAUD.FRAC.FP / 8.0;
+                baud = div ? ref / (samples * div) : 0;
+            } else {
+                baud = ref / samples * (1 - sercom->USART.BAUD.reg / 65536.0);
+            }
+            uint8_t chsize = sercom->USART.CTRLB.bit.CHSIZE;
+            uint8_t form = sercom->USART.CTRLA.bit.FORM;
+            uint8_t bits = 1 + ((chsize >= 5) ? chsize : 8 + chsize);
+            bits += (form == 0x1 || form == 0x5) ? 1 : 0;
+            bits += sercom->USART.CTRLB.bit.SBMODE ? 2 : 1;
+            return baud / bits;
+        }
+        case 0x3:
+            // SPI master
+            return ref / (2 * (sercom->SPI.BAUD.reg + 1)) / (sercom->SPI.CTRLB.bit.CHSIZE ? 9 : 8);
+        case 0x5: {
+            // I2C master, approximate since rise time isn't known
+            uint32_t low = sercom->I2CM.BAUD.bit.BAUDLOW ? sercom->I2CM.BAUD.bit.BAUDLOW : sercom->I2CM.BAUD.bit.BAUD;
+            return ref / (10 + sercom->I2CM.BAUD.bit.BAUD + low) / 9;
+        }
+    }
+    return 0;
+}
+
+// periods per second (the rate of OVF and MC DMA triggers) of a TC
+float fourRegsTCHz(uint8_t idx) {
+    Tc* tc = fourRegsTC(idx);
+    if (!tc || !tc->COUNT8.CTRLA.bit.ENABLE || tc->COUNT8.STATUS.bit.SLAVE) {
+        return 0;
+    }
+    float ref = fourRegsChannelHz(FourRegsTC_PCHs[idx]);
+    ref /= FourRegsTC_PRESCALERs[tc->COUNT8.CTRLA.bit.PRESCALER];
+    uint8_t wavegen = tc->COUNT8.WAVE.bit.WAVEGEN;
+    bool cctop = (wavegen == 0x1 || wavegen == 0x3);
+    uint32_t top;
+    switch (tc->COUNT8.CTRLA.bit.MODE) {
+        case 0x0: top = cctop ? tc->COUNT16.CC[0].reg : 0xFFFF; break;
+        case 0x1: top = cctop ? tc->COUNT8.CC[0].reg : tc->COUNT8.PER.reg; break;
+        case 0x2: top = cctop ? tc->COUNT32.CC[0].reg : 0xFFFFFFFF; break;
+        default: return 0;
+    }
+    return ref / (top + 1.0);
+}
+
+// periods per second (the rate of OVF and MC DMA triggers) of a TCC
+float fourRegsTCCHz(uint8_t idx) {
+    Tcc* tcc = fourRegsTCC(idx);
+    if (!tcc || !tcc->CTRLA.bit.ENABLE) {
+        return 0;
+    }
+    float ref = fourRegsChannelHz(FourRegsTCC_PCHs[idx]);
+    ref /= FourRegsTC_PRESCALERs[tcc->CTRLA.bit.PRESCALER];
+    uint8_t wavegen = tcc->WAVE.bit.WAVEGEN;
+    float period = ((wavegen == 0x1) ? tcc->CC[0].reg : tcc->PER.reg) + 1.0;
+    if (wavegen >= 0x4) {
+        // dual slope
+        period *= 2;
+    }
+    return ref / period;
+}
+
+
+// Board pin names come from the Arduino variant (see WVariant.h), which only
+// exists when building with an Arduino core.
+#ifdef PINS_COUNT
+struct FourRegsARDUINO_Label {
+    uint8_t     pin;
+    const char* name;
+};
+static const FourRegsARDUINO_Label FourRegsARDUINO_labels[] = {
+#ifdef PIN_A0
+    { PIN_A0, "A0" },
+#endif
+#ifdef PIN_A1
+    { PIN_A1, "A1" },
+#endif
+#ifdef PIN_A2
+    { PIN_A2, "A2" },
+#endif
+#ifdef PIN_A3
+    { PIN_A3, "A3" },
+#endif
+#ifdef PIN_A4
+    { PIN_A4, "A4" },
+#endif
+#ifdef PIN_A5
+    { PIN_A5, "A5" },
+#endif
+#ifdef PIN_A6
+    { PIN_A6, "A6" },
+#endif
+#ifdef PIN_A7
+    { PIN_A7, "A7" },
+#endif
+#ifdef PIN_A8
+    { PIN_A8, "A8" },
+#endif
+#ifdef PIN_A9
+    { PIN_A9, "A9" },
+#endif
+#ifdef PIN_A10
+    { PIN_A10, "A10" },
+#endif
+#ifdef PIN_A11
+    { PIN_A11, "A11" },
+#endif
+#ifdef PIN_A12
+    { PIN_A12, "A12" },
+#endif
+#ifdef PIN_A13
+    { PIN_A13, "A13" },
+#endif
+#ifdef PIN_A14
+    { PIN_A14, "A14" },
+#endif
+#ifdef PIN_A15
+    { PIN_A15, "A15" },
+#endif
+#ifdef PIN_WIRE_SDA
+    { PIN_WIRE_SDA, "SDA" },
+#endif
+#ifdef PIN_WIRE_SCL
+    { PIN_WIRE_SCL, "SCL" },
+#endif
+#ifdef PIN_SPI_MISO
+    { PIN_SPI_MISO, "MISO" },
+#endif
+#ifdef PIN_SPI_MOSI
+    { PIN_SPI_MOSI, "MOSI" },
+#endif
+#ifdef PIN_SPI_SCK
+    { PIN_SPI_SCK, "SCK" },
+#endif
+#ifdef LED_BUILTIN
+    { LED_BUILTIN, "LED" },
+#endif
+};
+#define FourRegsARDUINO_LABELCOUNT (sizeof(FourRegsARDUINO_labels) / sizeof(FourRegsARDUINO_Label))
+
+// reverse of g_APinDescription, 0xFF for pins the board doesn't name
+static uint8_t FourRegsARDUINO_pins[4][32];
+static bool FourRegsARDUINO_indexed = false;
+
+bool fourRegsARDUINO_isPin(uint8_t arduino, uint8_t gid, uint8_t pid) {
+    const PinDescription &desc = g_APinDescription[arduino];
+    return desc.ulPort == (EPortType) gid && desc.ulPin == pid;
+}
+#endif
+
+// Arduino pin number of a PORT pin, 0xFF if it hasn't one.
+uint8_t fourRegsArduinoPin(uint8_t gid, uint8_t pid) {
+#ifdef PINS_COUNT
+    if (!FourRegsARDUINO_indexed) {
+        memset(FourRegsARDUINO_pins, 0xFF, sizeof(FourRegsARDUINO_pins));
+        // walk backwards so that the lowest number wins for pins which appear twice
+        for (int16_t arduino = PINS_COUNT - 1; arduino >= 0; arduino--) {
+            const PinDescription &desc = g_APinDescription[arduino];
+            if (desc.ulPort < 0 || desc.ulPort > 3 || desc.ulPin > 31) {
+                continue;
+            }
+            FourRegsARDUINO_pins[desc.ulPort][desc.ulPin] = arduino;
+        }
+        FourRegsARDUINO_indexed = true;
+    }
+    return FourRegsARDUINO_pins[gid][pid];
+#else
+    return 0xFF;
+#endif
+}
+
+// prints " arduino=D13", or " arduino=D14/A0" when the variant gives the pin a name,
+// returns false if the pin isn't a board pin
+bool printFourReg_ARDUINO(FourRegOptions &opts, uint8_t gid, uint8_t pid, const char* prefix = " arduino=D") {
+    uint8_t arduino = fourRegsArduinoPin(gid, pid);
+    if (arduino == 0xFF) {
+        return false;
+    }
+    opts.print.print(prefix);
+    opts.print.print(arduino);
+#ifdef PINS_COUNT
+    for (uint8_t i = 0; i < FourRegsARDUINO_LABELCOUNT; i++) {
+        // compare pins not numbers, since variants sometimes give SDA/SCL/etc their own number
+        if (fourRegsARDUINO_isPin(FourRegsARDUINO_labels[i].pin, gid, pid)) {
+            opts.print.print("/");
+            opts.print.print(FourRegsARDUINO_labels[i].name);
+        }
+    }
+#endif
+    return true;
+}
+
 void printFourRegAC(FourRegOptions &opts) {
     while (AC->SYNCBUSY.bit.ENABLE) {}
     if (!AC->CTRLA.bit.ENABLE && !opts.showDisabled) {
@@ -79,10 +446,12 @@ void printFourRegAC(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- AC");
 
+    PRINTRAW(AC->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(AC->CTRLA, ENABLE);
     PRINTNL();
 
+    PRINTRAW(AC->EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     PRINTFLAG(AC->EVCTRL, COMPEO0);
     PRINTFLAG(AC->EVCTRL, COMPEO1);
@@ -94,6 +463,7 @@ void printFourRegAC(FourRegOptions &opts) {
     PRINTNL();
 
     while (AC->SYNCBUSY.bit.WINCTRL) {}
+    PRINTRAW(AC->WINCTRL.reg);
     opts.print.print("WINCTRL: ");
     PRINTFLAG(AC->WINCTRL, WEN0);
     opts.print.print(" WINTSEL0=");
@@ -167,6 +537,7 @@ void printFourRegAC(FourRegOptions &opts) {
         PRINTNL();
     }
 
+    PRINTRAW(AC->CALIB.reg);
     opts.print.print("CALIB:  ");
     PRINTHEX(AC->CALIB.bit.BIAS0);
     PRINTNL();
@@ -186,6 +557,7 @@ void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx) {
     }
     PRINTNL();
 
+    PRINTRAW(adc->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(adc->CTRLA, ENABLE);
     if (ADC1->CTRLA.bit.SLAVEEN == 1) {
@@ -203,6 +575,7 @@ void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx) {
     PRINTFLAG(adc->CTRLA, R2R);
     PRINTNL();
 
+    PRINTRAW(adc->EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     PRINTFLAG(adc->EVCTRL, FLUSHEI);
     PRINTFLAG(adc->EVCTRL, STARTEI);
@@ -213,6 +586,7 @@ void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx) {
     PRINTNL();
 
     while (adc->SYNCBUSY.bit.INPUTCTRL) {}
+    PRINTRAW(adc->INPUTCTRL.reg);
     opts.print.print("INPUTCTRL: ");
     opts.print.print(" muxpos=");
     if (adc->INPUTCTRL.bit.MUXPOS <= 23) {
@@ -248,6 +622,7 @@ void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx) {
     PRINTNL();
 
     while (adc->SYNCBUSY.bit.CTRLB) {}
+    PRINTRAW(adc->CTRLB.reg);
     opts.print.print("CTRLB: ");
     PRINTFLAG(adc->CTRLB, LEFTADJ);
     PRINTFLAG(adc->CTRLB, FREERUN);
@@ -265,6 +640,7 @@ void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx) {
     PRINTNL();
 
     while (adc->SYNCBUSY.bit.REFCTRL) {}
+    PRINTRAW(adc->REFCTRL.reg);
     opts.print.print("REFCTRL:  refsel=");
     switch (adc->REFCTRL.bit.REFSEL) {
         case 0x0: opts.print.print("INTREF"); break;
@@ -279,6 +655,7 @@ void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx) {
     PRINTNL();
 
     while (adc->SYNCBUSY.bit.AVGCTRL) {}
+    PRINTRAW(adc->AVGCTRL.reg);
     opts.print.print("AVGCTRL:  SAMPLENUM=");
     PRINTHEX(adc->AVGCTRL.bit.SAMPLENUM);
     opts.print.print(" ADJRES=");
@@ -286,17 +663,20 @@ void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx) {
     PRINTNL();
 
     while (adc->SYNCBUSY.bit.SAMPCTRL) {}
+    PRINTRAW(adc->SAMPCTRL.reg);
     opts.print.print("SAMPCTRL:  SAMPLEN=");
     PRINTHEX(adc->SAMPCTRL.bit.SAMPLEN);
     PRINTFLAG(adc->SAMPCTRL, OFFCOMP);
     PRINTNL();
 
     while (adc->SYNCBUSY.bit.WINLT) {}
+    PRINTRAW(adc->WINLT.reg);
     opts.print.print("WINLT:  ");
     opts.print.print(adc->WINLT.bit.WINLT);
     PRINTNL();
 
     while (adc->SYNCBUSY.bit.WINUT) {}
+    PRINTRAW(adc->WINUT.reg);
     opts.print.print("WINUT:  ");
     opts.print.print(adc->WINUT.bit.WINUT);
     PRINTNL();
@@ -304,16 +684,19 @@ void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx) {
     while (adc->SYNCBUSY.bit.CTRLB) {}
     if (adc->CTRLB.bit.CORREN) {
         while (adc->SYNCBUSY.bit.GAINCORR) {}
+        PRINTRAW(adc->GAINCORR.reg);
         opts.print.print("GAINCORR:  ");
         opts.print.print(adc->GAINCORR.bit.GAINCORR);
         PRINTNL();
 
         while (adc->SYNCBUSY.bit.OFFSETCORR) {}
+        PRINTRAW(adc->OFFSETCORR.reg);
         opts.print.print("OFFSETCORR:  ");
         opts.print.print(adc->OFFSETCORR.bit.OFFSETCORR);
         PRINTNL();
     }
 
+    PRINTRAW(adc->DSEQCTRL.reg);
     opts.print.print("DSEQCTRL: ");
     PRINTFLAG(adc->DSEQCTRL, INPUTCTRL);
     PRINTFLAG(adc->DSEQCTRL, CTRLB);
@@ -327,6 +710,7 @@ void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx) {
     PRINTFLAG(adc->DSEQCTRL, AUTOSTART);
     PRINTNL();
 
+    PRINTRAW(adc->CALIB.reg);
     opts.print.print("CALIB:  BIASCOMP=");
     PRINTHEX(adc->CALIB.bit.BIASCOMP);
     opts.print.print(" BIASR2R=");
@@ -343,6 +727,7 @@ void printFourRegAES(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- AES");
 
+    PRINTRAW(AES->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(AES->CTRLA, ENABLE);
     opts.print.print(" aesmode=");
@@ -376,6 +761,7 @@ void printFourRegAES(FourRegOptions &opts) {
     PRINTHEX(AES->CTRLA.bit.CTYPE);
     PRINTNL();
 
+    PRINTRAW(AES->CTRLB.reg);
     opts.print.print("CTRLB: ");
     PRINTFLAG(AES->CTRLB, EOM);
     PRINTFLAG(AES->CTRLB, GFMUL);
@@ -383,6 +769,214 @@ void printFourRegAES(FourRegOptions &opts) {
 }
 
 
+#ifdef CAN0
+// data field sizes of message RAM elements (RXESC and TXESC registers)
+static const uint8_t FourRegsCAN_DATASIZEs[8] = { 8, 12, 16, 20, 24, 32, 48, 64 };
+
+void printFourRegCAN_BITRATE(FourRegOptions &opts, uint32_t hz, uint16_t brp, uint16_t tseg1, uint16_t tseg2) {
+    // one sync segment plus both time segments, all of which are the register values plus one
+    uint32_t tqs = 1 + (tseg1 + 1) + (tseg2 + 1);
+    opts.print.print(" bitrate=");
+    printFourReg_HZ(opts, hz / ((brp + 1) * tqs));
+    opts.print.print(" sample=");
+    opts.print.print((100 * (1 + tseg1 + 1)) / tqs);
+    opts.print.print("%");
+}
+
+// Prints where a section of the message RAM is, and returns its size in bytes.
+uint32_t printFourRegCAN_SECTION(FourRegOptions &opts, uint16_t addr, uint8_t count, uint8_t elementSize) {
+    uint32_t bytes = (uint32_t) count * elementSize;
+    opts.print.print(" addr=");
+    PRINTHEX(HSRAM_ADDR | addr);
+    opts.print.print(" count=");
+    opts.print.print(count);
+    opts.print.print(" bytes=");
+    opts.print.print(bytes);
+    return bytes;
+}
+
+void printFourRegCAN(FourRegOptions &opts, Can* can, uint8_t idx) {
+    bool enabled = (idx == 0) ? MCLK->AHBMASK.bit.CAN0_ : MCLK->AHBMASK.bit.CAN1_;
+    if (!enabled) {
+        if (opts.showDisabled) {
+            opts.print.print("--------------------------- CAN");
+            opts.print.print(idx);
+            PRINTNL();
+            opts.print.println(FourRegs__DISABLED);
+        }
+        return;
+    }
+    opts.print.print("--------------------------- CAN");
+    opts.print.print(idx);
+    PRINTNL();
+
+    PRINTRAW(can->CCCR.reg);
+    opts.print.print("CCCR: ");
+    PRINTFLAG(can->CCCR, INIT);
+    PRINTFLAG(can->CCCR, CCE);
+    PRINTFLAG(can->CCCR, ASM);
+    PRINTFLAG(can->CCCR, CSA);
+    PRINTFLAG(can->CCCR, CSR);
+    PRINTFLAG(can->CCCR, MON);
+    PRINTFLAG(can->CCCR, DAR);
+    PRINTFLAG(can->CCCR, TEST);
+    PRINTFLAG(can->CCCR, FDOE);
+    PRINTFLAG(can->CCCR, BRSE);
+    PRINTFLAG(can->CCCR, PXHD);
+    PRINTFLAG(can->CCCR, EFBI);
+    PRINTFLAG(can->CCCR, TXP);
+    PRINTFLAG(can->CCCR, NISO);
+    PRINTNL();
+
+    uint32_t hz = fourRegsChannelHz(idx == 0 ? 27 : 28);
+    PRINTRAW(can->NBTP.reg);
+    opts.print.print("NBTP:  NBRP=");
+    PRINTHEX(can->NBTP.bit.NBRP);
+    opts.print.print(" NTSEG1=");
+    PRINTHEX(can->NBTP.bit.NTSEG1);
+    opts.print.print(" NTSEG2=");
+    PRINTHEX(can->NBTP.bit.NTSEG2);
+    opts.print.print(" NSJW=");
+    PRINTHEX(can->NBTP.bit.NSJW);
+    printFourRegCAN_BITRATE(opts, hz, can->NBTP.bit.NBRP, can->NBTP.bit.NTSEG1, can->NBTP.bit.NTSEG2);
+    PRINTNL();
+
+    if (can->CCCR.bit.FDOE || opts.showDisabled) {
+        PRINTRAW(can->DBTP.reg);
+        opts.print.print("DBTP:  DBRP=");
+        PRINTHEX(can->DBTP.bit.DBRP);
+        opts.print.print(" DTSEG1=");
+        PRINTHEX(can->DBTP.bit.DTSEG1);
+        opts.print.print(" DTSEG2=");
+        PRINTHEX(can->DBTP.bit.DTSEG2);
+        opts.print.print(" DSJW=");
+        PRINTHEX(can->DBTP.bit.DSJW);
+        PRINTFLAG(can->DBTP, TDC);
+        printFourRegCAN_BITRATE(opts, hz, can->DBTP.bit.DBRP, can->DBTP.bit.DTSEG1, can->DBTP.bit.DTSEG2);
+        PRINTNL();
+    }
+
+    PRINTRAW(can->MRCFG.reg);
+    opts.print.print("MRCFG:  qos=");
+    printFourReg_QOS(opts, can->MRCFG.bit.QOS);
+    PRINTNL();
+
+    PRINTRAW(can->GFC.reg);
+    opts.print.print("GFC: ");
+    PRINTFLAG(can->GFC, RRFE);
+    PRINTFLAG(can->GFC, RRFS);
+    opts.print.print(" anfe=");
+    switch (can->GFC.bit.ANFE) {
+        case 0x0: opts.print.print("RXF0"); break;
+        case 0x1: opts.print.print("RXF1"); break;
+        default:  opts.print.print("REJECT"); break;
+    }
+    opts.print.print(" anfs=");
+    switch (can->GFC.bit.ANFS) {
+        case 0x0: opts.print.print("RXF0"); break;
+        case 0x1: opts.print.print("RXF1"); break;
+        default:  opts.print.print("REJECT"); break;
+    }
+    PRINTNL();
+
+    // message RAM layout, the start addresses are offsets within HSRAM
+    uint32_t total = 0;
+    PRINTRAW(can->SIDFC.reg);
+    opts.print.print("SIDFC: ");
+    total += printFourRegCAN_SECTION(opts, can->SIDFC.bit.FLSSA, can->SIDFC.bit.LSS, 4);
+    PRINTNL();
+
+    PRINTRAW(can->XIDFC.reg);
+    opts.print.print("XIDFC: ");
+    total += printFourRegCAN_SECTION(opts, can->XIDFC.bit.FLESA, can->XIDFC.bit.LSE, 8);
+    PRINTNL();
+
+    PRINTRAW(can->RXF0C.reg);
+    opts.print.print("RXF0C: ");
+    total += printFourRegCAN_SECTION(opts, can->RXF0C.bit.F0SA, can->RXF0C.bit.F0S, 8 + FourRegsCAN_DATASIZEs[can->RXESC.bit.F0DS]);
+    opts.print.print(" F0WM=");
+    opts.print.print(can->RXF0C.bit.F0WM);
+    PRINTFLAG(can->RXF0C, F0OM);
+    PRINTNL();
+
+    PRINTRAW(can->RXF1C.reg);
+    opts.print.print("RXF1C: ");
+    total += printFourRegCAN_SECTION(opts, can->RXF1C.bit.F1SA, can->RXF1C.bit.F1S, 8 + FourRegsCAN_DATASIZEs[can->RXESC.bit.F1DS]);
+    opts.print.print(" F1WM=");
+    opts.print.print(can->RXF1C.bit.F1WM);
+    PRINTFLAG(can->RXF1C, F1OM);
+    PRINTNL();
+
+    // the number of dedicated RX buffers is decided by the filters, so only the element size is known
+    PRINTRAW(can->RXBC.reg);
+    opts.print.print("RXBC:  addr=");
+    PRINTHEX(HSRAM_ADDR | can->RXBC.bit.RBSA);
+    opts.print.print(" element=");
+    opts.print.print(8 + FourRegsCAN_DATASIZEs[can->RXESC.bit.RBDS]);
+    PRINTNL();
+
+    PRINTRAW(can->TXBC.reg);
+    opts.print.print("TXBC: ");
+    total += printFourRegCAN_SECTION(opts, can->TXBC.bit.TBSA, can->TXBC.bit.NDTB + can->TXBC.bit.TFQS, 8 + FourRegsCAN_DATASIZEs[can->TXESC.bit.TBDS]);
+    opts.print.print(" NDTB=");
+    opts.print.print(can->TXBC.bit.NDTB);
+    opts.print.print(" TFQS=");
+    opts.print.print(can->TXBC.bit.TFQS);
+    opts.print.print(" tfqm=");
+    opts.print.print(can->TXBC.bit.TFQM ? "QUEUE" : "FIFO");
+    PRINTNL();
+
+    PRINTRAW(can->TXEFC.reg);
+    opts.print.print("TXEFC: ");
+    total += printFourRegCAN_SECTION(opts, can->TXEFC.bit.EFSA, can->TXEFC.bit.EFS, 8);
+    opts.print.print(" EFWM=");
+    opts.print.print(can->TXEFC.bit.EFWM);
+    PRINTNL();
+
+    opts.print.print("MSGRAM:  bytes=");
+    opts.print.print(total);
+    PRINTNL();
+
+    // Reading ECR clears CEL, and reading PSR resets LEC and DLEC, which the
+    // application might be relying on.  So they are only read (once each)
+    // when showing everything.
+    if (!opts.showDisabled) {
+        return;
+    }
+    CAN_ECR_Type ecr;
+    COPYVOL(ecr, can->ECR);
+    PRINTRAW(ecr.reg);
+    opts.print.print("ECR:  TEC=");
+    opts.print.print(ecr.bit.TEC);
+    opts.print.print(" REC=");
+    opts.print.print(ecr.bit.REC);
+    PRINTFLAG(ecr, RP);
+    opts.print.print(" CEL=");
+    opts.print.print(ecr.bit.CEL);
+    PRINTNL();
+
+    CAN_PSR_Type psr;
+    COPYVOL(psr, can->PSR);
+    PRINTRAW(psr.reg);
+    opts.print.print("PSR: ");
+    opts.print.print(" act=");
+    switch (psr.bit.ACT) {
+        case 0x0: opts.print.print("SYNC"); break;
+        case 0x1: opts.print.print("IDLE"); break;
+        case 0x2: opts.print.print("RX"); break;
+        case 0x3: opts.print.print("TX"); break;
+    }
+    PRINTFLAG(psr, EP);
+    PRINTFLAG(psr, EW);
+    PRINTFLAG(psr, BO);
+    opts.print.print(" LEC=");
+    PRINTHEX(psr.bit.LEC);
+    opts.print.print(" DLEC=");
+    PRINTHEX(psr.bit.DLEC);
+    PRINTNL();
+}
+#endif
+
 void printFourRegCCL(FourRegOptions &opts) {
     uint8_t i;
     if (!CCL->CTRL.bit.ENABLE && !opts.showDisabled) {
@@ -390,6 +984,7 @@ void printFourRegCCL(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- CCL");
 
+    PRINTRAW(CCL->CTRL.reg);
     opts.print.print("CTRL: ");
     PRINTFLAG(CCL->CTRL, ENABLE);
     PRINTFLAG(CCL->CTRL, RUNSTDBY);
@@ -464,6 +1059,7 @@ void printFourRegCMCC(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- CMCC");
 
+    PRINTRAW(CMCC->TYPE.reg);
     opts.print.print("TYPE: ");
     // datasheet rev E has fields not in Atmel CMSIS header
     if (CMCC->TYPE.reg & (1<<0)) { opts.print.print(" AP"); }
@@ -493,6 +1089,7 @@ void printFourRegCMCC(FourRegOptions &opts) {
     }
     PRINTNL();
 
+    PRINTRAW(CMCC->CFG.reg);
     opts.print.print("CFG: ");
     PRINTFLAG(CMCC->CFG, ICDIS);
     PRINTFLAG(CMCC->CFG, DCDIS);
@@ -509,20 +1106,24 @@ void printFourRegCMCC(FourRegOptions &opts) {
     }
     PRINTNL();
 
+    PRINTRAW(CMCC->SR.reg);
     opts.print.print("SR: ");
     PRINTFLAG(CMCC->SR, CSTS);
     PRINTNL();
 
+    PRINTRAW(CMCC->LCKWAY.reg);
     opts.print.print("LCKWAY:  ");
     PRINTHEX(CMCC->LCKWAY.bit.LCKWAY);
     PRINTNL();
 
 
+    PRINTRAW(CMCC->MEN.reg);
     opts.print.print("MEN:  ");
     PRINTFLAG(CMCC->MEN, MENABLE);
     PRINTNL();
 
     if (CMCC->MEN.bit.MENABLE) {
+        PRINTRAW(CMCC->MCFG.reg);
         opts.print.print("MCFG:  mode=");
         switch (CMCC->MCFG.bit.MODE) {
             case 0x0: opts.print.print("CYCLE_COUNT"); break;
@@ -542,10 +1143,12 @@ void printFourRegDAC(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- DAC");
 
+    PRINTRAW(DAC->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(DAC->CTRLA, ENABLE);
     PRINTNL();
 
+    PRINTRAW(DAC->CTRLB.reg);
     opts.print.print("CTRLB:  diff=");
     opts.print.print(DAC->CTRLB.bit.DIFF ? "differential" : "single");
     opts.print.print(" refsel=");
@@ -557,6 +1160,7 @@ void printFourRegDAC(FourRegOptions &opts) {
     }
     PRINTNL();
 
+    PRINTRAW(DAC->EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     PRINTFLAG(DAC->EVCTRL, STARTEI0);
     PRINTFLAG(DAC->EVCTRL, STARTEI1);
@@ -602,189 +1206,698 @@ typedef union {
     uint8_t reg;
 } FourRegsDMAC_PRILVL;
 
-void printFourRegDMAC(FourRegOptions &opts) {
-    if (!DMAC->CTRL.bit.DMAENABLE && !opts.showDisabled) {
-        return;
-    }
-    opts.print.println("--------------------------- DMAC");
-
-    opts.print.print("CTRL: ");
-    PRINTFLAG(DMAC->CTRL, DMAENABLE);
-    PRINTFLAG(DMAC->CTRL, LVLEN0);
-    PRINTFLAG(DMAC->CTRL, LVLEN1);
-    PRINTFLAG(DMAC->CTRL, LVLEN2);
-    PRINTFLAG(DMAC->CTRL, LVLEN3);
-    PRINTNL();
+// in case of a bad pointer, stop following a descriptor list after this many
+#define FourRegsDMAC_MAXDESCS 16
 
-    opts.print.print("CRCCTRL:  CRCBEATSIZE=");
-    PRINTHEX(DMAC->CRCCTRL.bit.CRCBEATSIZE);
-    opts.print.print(" CRCPOLY=");
-    PRINTHEX(DMAC->CRCCTRL.bit.CRCPOLY);
-    opts.print.print(" CRCSRC=");
-    PRINTHEX(DMAC->CRCCTRL.bit.CRCSRC);
-    opts.print.print(" CRCMODE=");
-    PRINTHEX(DMAC->CRCCTRL.bit.CRCMODE);
-    PRINTNL();
+// descriptors need to be 128-bit aligned and in SRAM
+bool fourRegsDMAC_validDesc(uint32_t addr) {
+    return (addr >= HSRAM_ADDR) && (addr < HSRAM_ADDR + HSRAM_SIZE) && !(addr & 0xF);
+}
 
-    opts.print.print("PRICTRL0: ");
-    for (uint8_t lvl = 0; lvl < 4; lvl++) {
-        FourRegsDMAC_PRILVL pri;
-        pri.reg = (DMAC->PRICTRL0.reg >> (8 * lvl)) & 0xFF;
-        opts.print.print(" lvl");
-        opts.print.print(lvl);
-        opts.print.print(":qos=");
-        printFourReg_QOS(opts, pri.bit.QOS);
-        if (pri.bit.RREN) {
-            opts.print.print(",rren");
-        }
+void printFourRegDMAC_TRIGSRC(FourRegOptions &opts, uint8_t trigsrc) {
+    switch (trigsrc) {
+        case 0x00: opts.print.print("DISABLE"); break;
+        case 0x01: opts.print.print("RTC:TIMESTAMP"); break;
+        case 0x02: opts.print.print("DSU:DCC0"); break;
+        case 0x03: opts.print.print("DSU:DCC1"); break;
+        case 0x04: opts.print.print("SERCOM0:RX"); break;
+        case 0x05: opts.print.print("SERCOM0:TX"); break;
+        case 0x06: opts.print.print("SERCOM1:RX"); break;
+        case 0x07: opts.print.print("SERCOM1:TX"); break;
+        case 0x08: opts.print.print("SERCOM2:RX"); break;
+        case 0x09: opts.print.print("SERCOM2:TX"); break;
+        case 0x0A: opts.print.print("SERCOM3:RX"); break;
+        case 0x0B: opts.print.print("SERCOM3:TX"); break;
+        case 0x0C: opts.print.print("SERCOM4:RX"); break;
+        case 0x0D: opts.print.print("SERCOM4:TX"); break;
+        case 0x0E: opts.print.print("SERCOM5:RX"); break;
+        case 0x0F: opts.print.print("SERCOM5:TX"); break;
+        case 0x10: opts.print.print("SERCOM6:RX"); break;
+        case 0x11: opts.print.print("SERCOM6:TX"); break;
+        case 0x12: opts.print.print("SERCOM7:RX"); break;
+        case 0x13: opts.print.print("SERCOM7:TX"); break;
+        case 0x14: opts.print.print("CAN0:DEBUG"); break;
+        case 0x15: opts.print.print("CAN1:DEBUG"); break;
+        case 0x16: opts.print.print("TCC0:OVF"); break;
+        case 0x17: opts.print.print("TCC0:MC0"); break;
+        case 0x18: opts.print.print("TCC0:MC1"); break;
+        case 0x19: opts.print.print("TCC0:MC2"); break;
+        case 0x1A: opts.print.print("TCC0:MC3"); break;
+        case 0x1B: opts.print.print("TCC0:MC4"); break;
+        case 0x1C: opts.print.print("TCC0:MC5"); break;
+        case 0x1D: opts.print.print("TCC1:OVF"); break;
+        case 0x1E: opts.print.print("TCC1:MC0"); break;
+        case 0x1F: opts.print.print("TCC1:MC1"); break;
+        case 0x20: opts.print.print("TCC1:MC2"); break;
+        case 0x21: opts.print.print("TCC1:MC3"); break;
+        case 0x22: opts.print.print("TCC2:OVF"); break;
+        case 0x23: opts.print.print("TCC2:MC0"); break;
+        case 0x24: opts.print.print("TCC2:MC1"); break;
+        case 0x25: opts.print.print("TCC2:MC2"); break;
+        case 0x26: opts.print.print("TCC3:OVF"); break;
+        case 0x27: opts.print.print("TCC3:MC0"); break;
+        case 0x28: opts.print.print("TCC3:MC1"); break;
+        case 0x29: opts.print.print("TCC4:OVF"); break;
+        case 0x2A: opts.print.print("TCC4:MC0"); break;
+        case 0x2B: opts.print.print("TCC4:MC1"); break;
+        case 0x2C: opts.print.print("TC0:OVF"); break;
+        case 0x2D: opts.print.print("TC0:MC0"); break;
+        case 0x2E: opts.print.print("TC0:MC1"); break;
+        case 0x2F: opts.print.print("TC1:OVF"); break;
+        case 0x30: opts.print.print("TC1:MC0"); break;
+        case 0x31: opts.print.print("TC1:MC1"); break;
+        case 0x32: opts.print.print("TC2:OVF"); break;
+        case 0x33: opts.print.print("TC2:MC0"); break;
+        case 0x34: opts.print.print("TC2:MC1"); break;
+        case 0x35: opts.print.print("TC3:OVF"); break;
+        case 0x36: opts.print.print("TC3:MC0"); break;
+        case 0x37: opts.print.print("TC3:MC1"); break;
+        case 0x38: opts.print.print("TC4:OVF"); break;
+        case 0x39: opts.print.print("TC4:MC0"); break;
+        case 0x3A: opts.print.print("TC4:MC1"); break;
+        case 0x3B: opts.print.print("TC5:OVF"); break;
+        case 0x3C: opts.print.print("TC5:MC0"); break;
+        case 0x3D: opts.print.print("TC5:MC1"); break;
+        case 0x3E: opts.print.print("TC6:OVF"); break;
+        case 0x3F: opts.print.print("TC6:MC0"); break;
+        case 0x40: opts.print.print("TC6:MC1"); break;
+        case 0x41: opts.print.print("TC7:OVF"); break;
+        case 0x42: opts.print.print("TC7:MC0"); break;
+        case 0x43: opts.print.print("TC7:MC1"); break;
+        case 0x44: opts.print.print("ADC0:RESRDY"); break;
+        case 0x45: opts.print.print("ADC0:SEQ"); break;
+        case 0x46: opts.print.print("ADC1:RESRDY"); break;
+        case 0x47: opts.print.print("ADC1:SEQ"); break;
+        case 0x48: opts.print.print("DAC0:EMPTY"); break;
+        case 0x49: opts.print.print("DAC1:EMPTY"); break;
+        case 0x4A: opts.print.print("DAC0:RESRDY"); break;
+        case 0x4B: opts.print.print("DAC1:RESRDY"); break;
+        case 0x4C: opts.print.print("I2S0:RX"); break;
+        case 0x4D: opts.print.print("I2S1:RX"); break;
+        case 0x4E: opts.print.print("I2S0:TX"); break;
+        case 0x4F: opts.print.print("I2S1:TX"); break;
+        case 0x50: opts.print.print("PCC:RX"); break;
+        case 0x51: opts.print.print("AES:WR"); break;
+        case 0x52: opts.print.print("AES:RD"); break;
+        case 0x53: opts.print.print("QSPI:RX"); break;
+        case 0x54: opts.print.print("QSPI:TX"); break;
+        default: opts.print.print(FourRegs__UNKNOWN); break;
     }
-    PRINTNL();
+}
 
-    for (uint8_t id = 0; id < 32; id++) {
-        DmacChannel ch;
-        COPYVOL(ch, DMAC->Channel[id]);
-        if (!ch.CHCTRLA.bit.ENABLE && !opts.showDisabled) {
-            continue;
-        }
+// rate of DMA triggers, in Hz
+float fourRegsDMAC_triggerHz(uint8_t trigsrc) {
+    if (trigsrc >= 0x04 && trigsrc <= 0x13) {
+        return fourRegsSERCOMCharHz((trigsrc - 0x04) / 2);
+    }
+    if (trigsrc >= 0x16 && trigsrc <= 0x1C) { return fourRegsTCCHz(0); }
+    if (trigsrc >= 0x1D && trigsrc <= 0x21) { return fourRegsTCCHz(1); }
+    if (trigsrc >= 0x22 && trigsrc <= 0x25) { return fourRegsTCCHz(2); }
+    if (trigsrc >= 0x26 && trigsrc <= 0x28) { return fourRegsTCCHz(3); }
+    if (trigsrc >= 0x29 && trigsrc <= 0x2B) { return fourRegsTCCHz(4); }
+    if (trigsrc >= 0x2C && trigsrc <= 0x43) {
+        return fourRegsTCHz((trigsrc - 0x2C) / 3);
+    }
+    return 0;
+}
 
-        opts.print.print("CHANNEL");
-        PRINTPAD2(id);
-        opts.print.print(": ");
-        PRINTFLAG(ch.CHCTRLA, ENABLE);
-        PRINTFLAG(ch.CHCTRLA, RUNSTDBY);
-        opts.print.print(" trigsrc=");
-        switch (ch.CHCTRLA.bit.TRIGSRC) {
-            case 0x00: opts.print.print("DISABLE"); break;
-            case 0x01: opts.print.print("RTC:TIMESTAMP"); break;
-            case 0x02: opts.print.print("DSU:DCC0"); break;
-            case 0x03: opts.print.print("DSU:DCC1"); break;
-            case 0x04: opts.print.print("SERCOM0:RX"); break;
-            case 0x05: opts.print.print("SERCOM0:TX"); break;
-            case 0x06: opts.print.print("SERCOM1:RX"); break;
-            case 0x07: opts.print.print("SERCOM1:TX"); break;
-            case 0x08: opts.print.print("SERCOM2:RX"); break;
-            case 0x09: opts.print.print("SERCOM2:TX"); break;
-            case 0x0A: opts.print.print("SERCOM3:RX"); break;
-            case 0x0B: opts.print.print("SERCOM3:TX"); break;
-            case 0x0C: opts.print.print("SERCOM4:RX"); break;
-            case 0x0D: opts.print.print("SERCOM4:TX"); break;
-            case 0x0E: opts.print.print("SERCOM5:RX"); break;
-            case 0x0F: opts.print.print("SERCOM5:TX"); break;
-            case 0x10: opts.print.print("SERCOM6:RX"); break;
-            case 0x11: opts.print.print("SERCOM6:TX"); break;
-            case 0x12: opts.print.print("SERCOM7:RX"); break;
-            case 0x13: opts.print.print("SERCOM7:TX"); break;
-            case 0x14: opts.print.print("CAN0:DEBUG"); break;
-            case 0x15: opts.print.print("CAN1:DEBUG"); break;
-            case 0x16: opts.print.print("TCC0:OVF"); break;
-            case 0x17: opts.print.print("TCC0:MC0"); break;
-            case 0x18: opts.print.print("TCC0:MC1"); break;
-            case 0x19: opts.print.print("TCC0:MC2"); break;
-            case 0x1A: opts.print.print("TCC0:MC3"); break;
-            case 0x1B: opts.print.print("TCC0:MC4"); break;
-            case 0x1C: opts.print.print("TCC0:MC5"); break;
-            case 0x1D: opts.print.print("TCC1:OVF"); break;
-            case 0x1E: opts.print.print("TCC1:MC0"); break;
-            case 0x1F: opts.print.print("TCC1:MC1"); break;
-            case 0x20: opts.print.print("TCC1:MC2"); break;
-            case 0x21: opts.print.print("TCC1:MC3"); break;
-            case 0x22: opts.print.print("TCC2:OVF"); break;
-            case 0x23: opts.print.print("TCC2:MC0"); break;
-            case 0x24: opts.print.print("TCC2:MC1"); break;
-            case 0x25: opts.print.print("TCC2:MC2"); break;
-            case 0x26: opts.print.print("TCC3:OVF"); break;
-            case 0x27: opts.print.print("TCC3:MC0"); break;
-            case 0x28: opts.print.print("TCC3:MC1"); break;
-            case 0x29: opts.print.print("TCC4:OVF"); break;
-            case 0x2A: opts.print.print("TCC4:MC0"); break;
-            case 0x2B: opts.print.print("TCC4:MC1"); break;
-            case 0x2C: opts.print.print("TC0:OVF"); break;
-            case 0x2D: opts.print.print("TC0:MC0"); break;
-            case 0x2E: opts.print.print("TC0:MC1"); break;
-            case 0x2F: opts.print.print("TC1:OVF"); break;
-            case 0x30: opts.print.print("TC1:MC0"); break;
-            case 0x31: opts.print.print("TC1:MC1"); break;
-            case 0x32: opts.print.print("TC2:OVF"); break;
-            case 0x33: opts.print.print("TC2:MC0"); break;
-            case 0x34: opts.print.print("TC2:MC1"); break;
-            case 0x35: opts.print.print("TC3:OVF"); break;
-            case 0x36: opts.print.print("TC3:MC0"); break;
-            case 0x37: opts.print.print("TC3:MC1"); break;
-            case 0x38: opts.print.print("TC4:OVF"); break;
-            case 0x39: opts.print.print("TC4:MC0"); break;
-            case 0x3A: opts.print.print("TC4:MC1"); break;
-            case 0x3B: opts.print.print("TC5:OVF"); break;
-            case 0x3C: opts.print.print("TC5:MC0"); break;
-            case 0x3D: opts.print.print("TC5:MC1"); break;
-            case 0x3E: opts.print.print("TC6:OVF"); break;
-            case 0x3F: opts.print.print("TC6:MC0"); break;
-            case 0x40: opts.print.print("TC6:MC1"); break;
-            case 0x41: opts.print.print("TC7:OVF"); break;
-            case 0x42: opts.print.print("TC7:MC0"); break;
-            case 0x43: opts.print.print("TC7:MC1"); break;
-            case 0x44: opts.print.print("ADC0:RESRDY"); break;
-            case 0x45: opts.print.print("ADC0:SEQ"); break;
-            case 0x46: opts.print.print("ADC1:RESRDY"); break;
-            case 0x47: opts.print.print("ADC1:SEQ"); break;
-            case 0x48: opts.print.print("DAC0:EMPTY"); break;
-            case 0x49: opts.print.print("DAC1:EMPTY"); break;
-            case 0x4A: opts.print.print("DAC0:RESRDY"); break;
-            case 0x4B: opts.print.print("DAC1:RESRDY"); break;
-            case 0x4C: opts.print.print("I2S0:RX"); break;
-            case 0x4D: opts.print.print("I2S1:RX"); break;
-            case 0x4E: opts.print.print("I2S0:TX"); break;
-            case 0x4F: opts.print.print("I2S1:TX"); break;
-            case 0x50: opts.print.print("PCC:RX"); break;
-            case 0x51: opts.print.print("AES:WR"); break;
-            case 0x52: opts.print.print("AES:RD"); break;
-            case 0x53: opts.print.print("QSPI:RX"); break;
-            case 0x54: opts.print.print("QSPI:TX"); break;
-            default: opts.print.print(FourRegs__UNKNOWN); break;
-        }
-        opts.print.print(" trigact=");
-        switch (ch.CHCTRLA.bit.TRIGACT) {
-            case 0x0: opts.print.print("BLOCK"); break;
-            /*case 0x1*/
-            case 0x2: opts.print.print("BURST"); break;
-            case 0x3: opts.print.print("TRANS"); break;
-            default: opts.print.print(FourRegs__RESERVED); break;
+void printFourRegDMAC_DESC(FourRegOptions &opts, DmacDescriptor &desc) {
+    PRINTFLAG(desc.BTCTRL, VALID);
+    opts.print.print(" beatsize=");
+    switch (desc.BTCTRL.bit.BEATSIZE) {
+        case 0x0: opts.print.print("BYTE"); break;
+        case 0x1: opts.print.print("HWORD"); break;
+        case 0x2: opts.print.print("WORD"); break;
+        default: opts.print.print(FourRegs__RESERVED); break;
+    }
+    opts.print.print(" BTCNT=");
+    opts.print.print(desc.BTCNT.reg);
+    // when incrementing, the address is the end of the transfer
+    opts.print.print(" SRCADDR=");
+    PRINTHEX(desc.SRCADDR.reg);
+    if (desc.BTCTRL.bit.SRCINC) {
+        opts.print.print(" srcinc=");
+        if (desc.BTCTRL.bit.STEPSEL) {
+            PRINTSCALE(desc.BTCTRL.bit.STEPSIZE);
+        } else {
+            opts.print.print(1);
         }
-        opts.print.print(" burstlen=");
-        opts.print.print(ch.CHCTRLA.bit.BURSTLEN);
         opts.print.print("BEAT");
-        opts.print.print(" threshold=");
-        PRINTSCALE(ch.CHCTRLA.bit.THRESHOLD);
-        opts.print.print("BEATS");
-        opts.print.print(" prilvl=LVL");
-        opts.print.print(ch.CHPRILVL.bit.PRILVL);
-        if (ch.CHEVCTRL.bit.EVIE) {
-            opts.print.print(" EVIE evact=");
-            switch (ch.CHEVCTRL.bit.EVACT) {
-                case 0x0: opts.print.print("NOACT"); break;
-                case 0x1: opts.print.print("TRIG"); break;
-                case 0x2: opts.print.print("CTRIG"); break;
-                case 0x3: opts.print.print("CBLOCK"); break;
-                case 0x4: opts.print.print("SUSPEND"); break;
-                case 0x5: opts.print.print("RESUME"); break;
-                case 0x6: opts.print.print("SSKIP"); break;
-                case 0x7: opts.print.print("INCPRI"); break;
-            }
+    }
+    opts.print.print(" DSTADDR=");
+    PRINTHEX(desc.DSTADDR.reg);
+    if (desc.BTCTRL.bit.DSTINC) {
+        opts.print.print(" dstinc=");
+        if (!desc.BTCTRL.bit.STEPSEL) {
+            PRINTSCALE(desc.BTCTRL.bit.STEPSIZE);
+        } else {
+            opts.print.print(1);
         }
-        if (ch.CHEVCTRL.bit.EVOE) {
-            opts.print.print(" EVOE evomode=");
-            switch (ch.CHEVCTRL.bit.EVOMODE) {
-                case 0x0: opts.print.print("DEFAULT"); break;
-                case 0x1: opts.print.print("TRIGACT"); break;
-                default: opts.print.print(FourRegs__RESERVED); break;
-            }
+        opts.print.print("BEAT");
+    }
+    opts.print.print(" blockact=");
+    switch (desc.BTCTRL.bit.BLOCKACT) {
+        case 0x0: opts.print.print("NOACT"); break;
+        case 0x1: opts.print.print("INT"); break;
+        case 0x2: opts.print.print("SUSPEND"); break;
+        case 0x3: opts.print.print("BOTH"); break;
+    }
+    if (desc.BTCTRL.bit.EVOSEL) {
+        opts.print.print(" evosel=");
+        switch (desc.BTCTRL.bit.EVOSEL) {
+            case 0x1: opts.print.print("BLOCK"); break;
+            case 0x3: opts.print.print("BURST"); break;
+            default: opts.print.print(FourRegs__RESERVED); break;
         }
-        PRINTNL();
     }
-
-    //FUTURE -- show DmacDescriptors?
 }
 
-
+// Walks the linked list of descriptors, then estimates the bandwidth.
+void printFourRegDMAC_DESCS(FourRegOptions &opts, uint8_t id, DmacChannel &ch) {
+    DmacDescriptor desc;
+    uint32_t addr;
+    uint32_t visited[FourRegsDMAC_MAXDESCS];
+    uint32_t blockBytes = 0;
+    uint32_t transBytes = 0;
+    uint8_t beatsize = 0;
+
+    addr = DMAC->WRBADDR.reg + id * sizeof(DmacDescriptor);
+    if (fourRegsDMAC_validDesc(addr)) {
+        COPYVOL(desc, *((DmacDescriptor*) addr));
+        opts.print.print("    WRB: ");
+        printFourRegDMAC_DESC(opts, desc);
+        opts.print.print(" next=");
+        PRINTHEX(desc.DESCADDR.reg);
+        PRINTNL();
+    }
+
+    addr = DMAC->BASEADDR.reg + id * sizeof(DmacDescriptor);
+    for (uint8_t n = 0; n < FourRegsDMAC_MAXDESCS; n++) {
+        opts.print.print("    DESC");
+        PRINTPAD2(n);
+        opts.print.print(":  ");
+        PRINTHEX(addr);
+        if (!fourRegsDMAC_validDesc(addr)) {
+            opts.print.println(" --bad address--");
+            break;
+        }
+        visited[n] = addr;
+        COPYVOL(desc, *((DmacDescriptor*) addr));
+        printFourRegDMAC_DESC(opts, desc);
+        uint32_t bytes = desc.BTCNT.reg << desc.BTCTRL.bit.BEATSIZE;
+        if (n == 0) {
+            blockBytes = bytes;
+            beatsize = desc.BTCTRL.bit.BEATSIZE;
+        }
+        transBytes += bytes;
+
+        addr = desc.DESCADDR.reg;
+        opts.print.print(" next=");
+        if (!addr) {
+            opts.print.println("END");
+            break;
+        }
+        uint8_t loop = 0;
+        while (loop <= n && visited[loop] != addr) {
+            loop++;
+        }
+        if (loop <= n) {
+            opts.print.print("DESC");
+            PRINTPAD2(loop);
+            opts.print.println("(loop)");
+            break;
+        }
+        PRINTHEX(addr);
+        PRINTNL();
+        if (n + 1 == FourRegsDMAC_MAXDESCS) {
+            opts.print.println("    --too many descriptors--");
+        }
+    }
+
+    opts.print.print("    RATE:  trigger=");
+    if (ch.CHCTRLA.bit.TRIGSRC == 0) {
+        opts.print.print("software");
+    } else {
+        float hz = fourRegsDMAC_triggerHz(ch.CHCTRLA.bit.TRIGSRC);
+        uint32_t bytes;
+        switch (ch.CHCTRLA.bit.TRIGACT) {
+            case 0x2:
+                bytes = (ch.CHCTRLA.bit.BURSTLEN + 1) << beatsize;
+                break;
+            case 0x3:
+                bytes = transBytes;
+                break;
+            default:
+                bytes = blockBytes;
+                break;
+        }
+        if (hz) {
+            opts.print.print(hz, 1);
+            opts.print.print("Hz");
+        } else {
+            opts.print.print("?");
+        }
+        opts.print.print(" bytes/trigger=");
+        opts.print.print(bytes);
+        if (hz) {
+            opts.print.print(" bytes/sec=");
+            opts.print.print(hz * bytes, 0);
+        }
+    }
+    opts.print.print(" bytes/block=");
+    opts.print.print(blockBytes);
+    PRINTNL();
+}
+
+void printFourRegDMAC_CHNAME(FourRegOptions &opts, uint8_t id) {
+    DMAC_CHCTRLA_Type ctrla;
+    COPYVOL(ctrla, DMAC->Channel[id].CHCTRLA);
+    opts.print.print("CHANNEL");
+    PRINTPAD2(id);
+    opts.print.print("(");
+    if (ctrla.bit.TRIGSRC) {
+        printFourRegDMAC_TRIGSRC(opts, ctrla.bit.TRIGSRC);
+    } else {
+        opts.print.print("software");
+    }
+    opts.print.print(")");
+}
+
+// a channel which moves a whole block or transaction for each trigger
+// holds the bus for a long time
+bool fourRegsDMAC_isBulk(uint8_t id) {
+    DMAC_CHCTRLA_Type ctrla;
+    COPYVOL(ctrla, DMAC->Channel[id].CHCTRLA);
+    return !ctrla.bit.TRIGSRC || ctrla.bit.TRIGACT != 0x2;
+}
+
+// Shows how channel priorities and bus QoS combine, and flags the
+// peripheral-triggered channels which might be starved.
+void printFourRegDMAC_QOS(FourRegOptions &opts) {
+    opts.print.println("--------------------------- DMAC QOS");
+
+    // level 3 wins, then within a level the lowest channel wins (unless round-robin)
+    for (int8_t lvl = 3; lvl >= 0; lvl--) {
+        FourRegsDMAC_PRILVL pri;
+        pri.reg = (DMAC->PRICTRL0.reg >> (8 * lvl)) & 0xFF;
+        bool any = false;
+        for (uint8_t id = 0; id < 32; id++) {
+            if (DMAC->Channel[id].CHCTRLA.bit.ENABLE && DMAC->Channel[id].CHPRILVL.bit.PRILVL == lvl) {
+                any = true;
+            }
+        }
+        if (!any && !opts.showDisabled) {
+            continue;
+        }
+        opts.print.print("LVL");
+        opts.print.print((int) lvl);
+        opts.print.print(": ");
+        if ((DMAC->CTRL.reg >> (DMAC_CTRL_LVLEN0_Pos + lvl)) & 0x1) {
+            opts.print.print(" LVLEN");
+        }
+        opts.print.print(pri.bit.RREN ? " arb=ROUNDROBIN" : " arb=STATIC");
+        opts.print.print(" qos=");
+        printFourReg_QOS(opts, pri.bit.QOS);
+        bool first = true;
+        for (uint8_t id = 0; id < 32; id++) {
+            if (DMAC->Channel[id].CHCTRLA.bit.ENABLE && DMAC->Channel[id].CHPRILVL.bit.PRILVL == lvl) {
+                opts.print.print(first ? " channels=" : ",");
+                printFourRegDMAC_CHNAME(opts, id);
+                first = false;
+            }
+        }
+        PRINTNL();
+    }
+
+    // the CMCC (and so the CPU) has no QoS setting
+    opts.print.print("BUSQOS: ");
+    for (uint8_t lvl = 0; lvl < 4; lvl++) {
+        FourRegsDMAC_PRILVL pri;
+        pri.reg = (DMAC->PRICTRL0.reg >> (8 * lvl)) & 0xFF;
+        opts.print.print(" dmac-lvl");
+        opts.print.print(lvl);
+        opts.print.print("=");
+        printFourReg_QOS(opts, pri.bit.QOS);
+    }
+    bool usb = USB->DEVICE.CTRLA.bit.ENABLE;
+    if (usb) {
+        opts.print.print(" usb-cqos=");
+        printFourReg_QOS(opts, USB->DEVICE.QOSCTRL.bit.CQOS);
+        opts.print.print(" usb-dqos=");
+        printFourReg_QOS(opts, USB->DEVICE.QOSCTRL.bit.DQOS);
+    }
+    opts.print.print(" cmcc=n/a");
+    PRINTNL();
+
+    bool starve = false;
+    for (uint8_t id = 0; id < 32; id++) {
+        DmacChannel ch;
+        COPYVOL(ch, DMAC->Channel[id]);
+        if (!ch.CHCTRLA.bit.ENABLE || !ch.CHCTRLA.bit.TRIGSRC) {
+            continue;
+        }
+        uint8_t lvl = ch.CHPRILVL.bit.PRILVL;
+        FourRegsDMAC_PRILVL pri;
+        pri.reg = (DMAC->PRICTRL0.reg >> (8 * lvl)) & 0xFF;
+        float hz = fourRegsDMAC_triggerHz(ch.CHCTRLA.bit.TRIGSRC);
+
+        if (!((DMAC->CTRL.reg >> (DMAC_CTRL_LVLEN0_Pos + lvl)) & 0x1)) {
+            opts.print.print("STARVE:  ");
+            printFourRegDMAC_CHNAME(opts, id);
+            opts.print.print(" LVL");
+            opts.print.print(lvl);
+            opts.print.println(" isn't enabled");
+            starve = true;
+        }
+        for (uint8_t other = 0; other < 32; other++) {
+            if (other == id || !DMAC->Channel[other].CHCTRLA.bit.ENABLE || !fourRegsDMAC_isBulk(other)) {
+                continue;
+            }
+            uint8_t otherlvl = DMAC->Channel[other].CHPRILVL.bit.PRILVL;
+            if (otherlvl < lvl || (otherlvl == lvl && (pri.bit.RREN || other > id))) {
+                continue;
+            }
+            opts.print.print("STARVE:  ");
+            printFourRegDMAC_CHNAME(opts, id);
+            if (hz) {
+                opts.print.print(" at ");
+                opts.print.print(hz, 0);
+                opts.print.print("Hz");
+            }
+            opts.print.print(" is behind bulk ");
+            printFourRegDMAC_CHNAME(opts, other);
+            opts.print.print(otherlvl == lvl ? " (static priority in LVL" : " (higher LVL");
+            opts.print.print(otherlvl);
+            opts.print.println(")");
+            starve = true;
+        }
+        if (usb && pri.bit.QOS < USB->DEVICE.QOSCTRL.bit.DQOS) {
+            opts.print.print("STARVE:  ");
+            printFourRegDMAC_CHNAME(opts, id);
+            opts.print.print(" has SRAM qos=");
+            printFourReg_QOS(opts, pri.bit.QOS);
+            opts.print.print(" below usb-dqos=");
+            printFourReg_QOS(opts, USB->DEVICE.QOSCTRL.bit.DQOS);
+            PRINTNL();
+            starve = true;
+        }
+    }
+    if (!starve) {
+        opts.print.println("STARVE:  none");
+    }
+}
+
+void printFourRegDMAC(FourRegOptions &opts) {
+    if (!DMAC->CTRL.bit.DMAENABLE && !opts.showDisabled) {
+        return;
+    }
+    opts.print.println("--------------------------- DMAC");
+
+    PRINTRAW(DMAC->CTRL.reg);
+    opts.print.print("CTRL: ");
+    PRINTFLAG(DMAC->CTRL, DMAENABLE);
+    PRINTFLAG(DMAC->CTRL, LVLEN0);
+    PRINTFLAG(DMAC->CTRL, LVLEN1);
+    PRINTFLAG(DMAC->CTRL, LVLEN2);
+    PRINTFLAG(DMAC->CTRL, LVLEN3);
+    PRINTNL();
+
+    PRINTRAW(DMAC->CRCCTRL.reg);
+    opts.print.print("CRCCTRL:  CRCBEATSIZE=");
+    PRINTHEX(DMAC->CRCCTRL.bit.CRCBEATSIZE);
+    opts.print.print(" CRCPOLY=");
+    PRINTHEX(DMAC->CRCCTRL.bit.CRCPOLY);
+    opts.print.print(" CRCSRC=");
+    PRINTHEX(DMAC->CRCCTRL.bit.CRCSRC);
+    opts.print.print(" CRCMODE=");
+    PRINTHEX(DMAC->CRCCTRL.bit.CRCMODE);
+    PRINTNL();
+
+    PRINTRAW(DMAC->PRICTRL0.reg);
+    opts.print.print("PRICTRL0: ");
+    for (uint8_t lvl = 0; lvl < 4; lvl++) {
+        FourRegsDMAC_PRILVL pri;
+        pri.reg = (DMAC->PRICTRL0.reg >> (8 * lvl)) & 0xFF;
+        opts.print.print(" lvl");
+        opts.print.print(lvl);
+        opts.print.print(":qos=");
+        printFourReg_QOS(opts, pri.bit.QOS);
+        if (pri.bit.RREN) {
+            opts.print.print(",rren");
+        }
+    }
+    PRINTNL();
+
+    PRINTRAW(DMAC->BASEADDR.reg);
+    opts.print.print("BASEADDR:  ");
+    PRINTHEX(DMAC->BASEADDR.reg);
+    PRINTNL();
+
+    PRINTRAW(DMAC->WRBADDR.reg);
+    opts.print.print("WRBADDR:  ");
+    PRINTHEX(DMAC->WRBADDR.reg);
+    PRINTNL();
+
+    for (uint8_t id = 0; id < 32; id++) {
+        DmacChannel ch;
+        COPYVOL(ch, DMAC->Channel[id]);
+        if (!ch.CHCTRLA.bit.ENABLE && !opts.showDisabled) {
+            continue;
+        }
+
+        opts.print.print("CHANNEL");
+        PRINTPAD2(id);
+        opts.print.print(": ");
+        PRINTFLAG(ch.CHCTRLA, ENABLE);
+        PRINTFLAG(ch.CHCTRLA, RUNSTDBY);
+        opts.print.print(" trigsrc=");
+        printFourRegDMAC_TRIGSRC(opts, ch.CHCTRLA.bit.TRIGSRC);
+        opts.print.print(" trigact=");
+        switch (ch.CHCTRLA.bit.TRIGACT) {
+            case 0x0: opts.print.print("BLOCK"); break;
+            /*case 0x1*/
+            case 0x2: opts.print.print("BURST"); break;
+            case 0x3: opts.print.print("TRANS"); break;
+            default: opts.print.print(FourRegs__RESERVED); break;
+        }
+        opts.print.print(" burstlen=");
+        opts.print.print(ch.CHCTRLA.bit.BURSTLEN);
+        opts.print.print("BEAT");
+        opts.print.print(" threshold=");
+        PRINTSCALE(ch.CHCTRLA.bit.THRESHOLD);
+        opts.print.print("BEATS");
+        opts.print.print(" prilvl=LVL");
+        opts.print.print(ch.CHPRILVL.bit.PRILVL);
+        if (ch.CHEVCTRL.bit.EVIE) {
+            opts.print.print(" EVIE evact=");
+            switch (ch.CHEVCTRL.bit.EVACT) {
+                case 0x0: opts.print.print("NOACT"); break;
+                case 0x1: opts.print.print("TRIG"); break;
+                case 0x2: opts.print.print("CTRIG"); break;
+                case 0x3: opts.print.print("CBLOCK"); break;
+                case 0x4: opts.print.print("SUSPEND"); break;
+                case 0x5: opts.print.print("RESUME"); break;
+                case 0x6: opts.print.print("SSKIP"); break;
+                case 0x7: opts.print.print("INCPRI"); break;
+            }
+        }
+        if (ch.CHEVCTRL.bit.EVOE) {
+            opts.print.print(" EVOE evomode=");
+            switch (ch.CHEVCTRL.bit.EVOMODE) {
+                case 0x0: opts.print.print("DEFAULT"); break;
+                case 0x1: opts.print.print("TRIGACT"); break;
+                default: opts.print.print(FourRegs__RESERVED); break;
+            }
+        }
+        PRINTNL();
+
+        if (ch.CHCTRLA.bit.ENABLE) {
+            printFourRegDMAC_DESCS(opts, id, ch);
+        }
+    }
+
+    printFourRegDMAC_QOS(opts);
+}
+
+
+// DID.SERIES and DID.DEVSEL of the SAMD51 and SAME51/53/54 parts (DSU DID
+// register, datasheet rev E)
+struct FourRegsDSU_Variant {
+    uint8_t     series;
+    uint8_t     devsel;
+    const char* name;
+    uint8_t     pins;
+};
+static const FourRegsDSU_Variant FourRegsDSU_VARIANTs[] = {
+    { 0x6, 0x00, "SAMD51P20A", 128 },
+    { 0x6, 0x01, "SAMD51P19A", 128 },
+    { 0x6, 0x02, "SAMD51N20A", 100 },
+    { 0x6, 0x03, "SAMD51N19A", 100 },
+    { 0x6, 0x04, "SAMD51J20A", 64 },
+    { 0x6, 0x05, "SAMD51J19A", 64 },
+    { 0x6, 0x06, "SAMD51J18A", 64 },
+    { 0x6, 0x07, "SAMD51G19A", 48 },
+    { 0x6, 0x08, "SAMD51G18A", 48 },
+    { 0x1, 0x00, "SAME51N20A", 100 },
+    { 0x1, 0x01, "SAME51N19A", 100 },
+    { 0x1, 0x02, "SAME51J19A", 64 },
+    { 0x1, 0x03, "SAME51J18A", 64 },
+    { 0x1, 0x04, "SAME51J20A", 64 },
+    { 0x1, 0x05, "SAME51G19A", 48 },
+    { 0x1, 0x06, "SAME51G18A", 48 },
+    { 0x3, 0x02, "SAME53N20A", 100 },
+    { 0x3, 0x03, "SAME53N19A", 100 },
+    { 0x3, 0x04, "SAME53J20A", 64 },
+    { 0x3, 0x05, "SAME53J19A", 64 },
+    { 0x3, 0x06, "SAME53J18A", 64 },
+    { 0x4, 0x00, "SAME54P20A", 128 },
+    { 0x4, 0x01, "SAME54P19A", 128 },
+    { 0x4, 0x02, "SAME54N20A", 100 },
+    { 0x4, 0x03, "SAME54N19A", 100 },
+};
+#define FourRegsDSU_VARIANTCOUNT (sizeof(FourRegsDSU_VARIANTs) / sizeof(FourRegsDSU_Variant))
+
+// Variant of the chip we're running on, NULL if it isn't a known SAMD51 or SAME5x.
+const FourRegsDSU_Variant* fourRegsDSU_variant() {
+    DSU_DID_Type did;
+    COPYVOL(did, DSU->DID);
+    if (did.bit.FAMILY != 0x0) {
+        return NULL;
+    }
+    for (uint8_t i = 0; i < FourRegsDSU_VARIANTCOUNT; i++) {
+        if (FourRegsDSU_VARIANTs[i].series == did.bit.SERIES && FourRegsDSU_VARIANTs[i].devsel == did.bit.DEVSEL) {
+            return &FourRegsDSU_VARIANTs[i];
+        }
+    }
+    return NULL;
+}
+
+// Number of PORT groups bonded out on this chip.  Read from the DSU the first
+// time it's needed, and 4 (all of them) if the variant isn't known.
+static uint8_t FourRegsDSU_portGroups = 0;
+uint8_t fourRegsPORTGroups() {
+    if (!FourRegsDSU_portGroups) {
+        const FourRegsDSU_Variant* variant = fourRegsDSU_variant();
+        uint8_t pins = variant ? variant->pins : 128;
+        FourRegsDSU_portGroups = (pins >= 128) ? 4 : ((pins >= 100) ? 3 : 2);
+    }
+    return FourRegsDSU_portGroups;
+}
+
+// CoreSight component names, by part number (ARM designed parts only)
+const char* fourRegsDSU_componentName(uint16_t part) {
+    switch (part) {
+        case 0x001: return "ITM";
+        case 0x002: return "DWT";
+        case 0x003: return "FPB";
+        case 0x00C: return "SCS";
+        case 0x4C4: return "ROMTABLE";
+        case 0x925: return "ETM";
+        case 0x9A1: return "TPIU";
+    }
+    return FourRegs__UNKNOWN;
+}
+
+// Prints the components listed in a CoreSight ROM table.  Nested ROM tables
+// are named but not walked.
+void printFourRegDSU_ROMTABLE(FourRegOptions &opts, uint32_t base) {
+    for (uint8_t id = 0; id < 32; id++) {
+        uint32_t entry = ((volatile uint32_t*) base)[id];
+        if (entry == 0) {
+            break;
+        }
+        if (!(entry & 0x1) && !opts.showDisabled) {
+            continue;
+        }
+        opts.print.print("ROM");
+        PRINTPAD2(id);
+        opts.print.print(":  addr=");
+        uint32_t addr = base + (entry & 0xFFFFF000);
+        PRINTHEX(addr);
+        if (!(entry & 0x1)) {
+            opts.print.print(" ");
+            opts.print.println(FourRegs__DISABLED);
+            continue;
+        }
+        volatile uint32_t* ids = (volatile uint32_t*) (addr + 0xFD0);
+        // PIDR0..3 are at 0xFE0, CIDR1 is at 0xFF4
+        uint16_t part = (ids[4] & 0xFF) | ((ids[5] & 0xF) << 8);
+        uint8_t designer = ((ids[5] >> 4) & 0xF) | ((ids[6] & 0x7) << 4);
+        opts.print.print(" class=");
+        PRINTHEX((ids[9] >> 4) & 0xF);
+        opts.print.print(" part=");
+        PRINTHEX(part);
+        opts.print.print(" component=");
+        opts.print.print((designer == 0x3B) ? fourRegsDSU_componentName(part) : FourRegs__UNKNOWN);
+        PRINTNL();
+    }
+}
+
+void printFourRegDSU(FourRegOptions &opts) {
+    opts.print.println("--------------------------- DSU");
+
+    DSU_DID_Type did;
+    COPYVOL(did, DSU->DID);
+    opts.print.print("DID:  PROCESSOR=");
+    PRINTHEX(did.bit.PROCESSOR);
+    opts.print.print(" FAMILY=");
+    PRINTHEX(did.bit.FAMILY);
+    opts.print.print(" SERIES=");
+    PRINTHEX(did.bit.SERIES);
+    opts.print.print(" DIE=");
+    PRINTHEX(did.bit.DIE);
+    opts.print.print(" revision=");
+    opts.print.print(char('A' + did.bit.REVISION));
+    opts.print.print(" DEVSEL=");
+    PRINTHEX(did.bit.DEVSEL);
+    const FourRegsDSU_Variant* variant = fourRegsDSU_variant();
+    if (variant) {
+        opts.print.print(" device=");
+        opts.print.print(variant->name);
+        opts.print.print(" pins=");
+        opts.print.print(variant->pins);
+    }
+    PRINTNL();
+
+    PRINTRAW(DSU->STATUSA.reg);
+    opts.print.print("STATUSA: ");
+    PRINTFLAG(DSU->STATUSA, DONE);
+    PRINTFLAG(DSU->STATUSA, CRSTEXT);
+    PRINTFLAG(DSU->STATUSA, BERR);
+    PRINTFLAG(DSU->STATUSA, FAIL);
+    PRINTFLAG(DSU->STATUSA, PERR);
+    PRINTNL();
+
+    PRINTRAW(DSU->STATUSB.reg);
+    opts.print.print("STATUSB: ");
+    PRINTFLAG(DSU->STATUSB, PROT);
+    PRINTFLAG(DSU->STATUSB, DBGPRES);
+    PRINTFLAG(DSU->STATUSB, DCCD0);
+    PRINTFLAG(DSU->STATUSB, DCCD1);
+    PRINTFLAG(DSU->STATUSB, HPE);
+    PRINTFLAG(DSU->STATUSB, CELCK);
+    PRINTFLAG(DSU->STATUSB, TDCCD0);
+    PRINTFLAG(DSU->STATUSB, TDCCD1);
+    PRINTNL();
+
+    // The DSU ROM table points to the Cortex-M4 ROM table.  The offsets are
+    // relative to the table itself, which wrap around to reach 0xE00FF000.
+    uint32_t dsuTable = ((uint32_t) &DSU->ENTRY0) & 0xFFFFF000;
+    PRINTRAW(DSU->ENTRY0.reg);
+    opts.print.print("ENTRY0:  addr=");
+    PRINTHEX(dsuTable + (DSU->ENTRY0.reg & 0xFFFFF000));
+    PRINTFLAG(DSU->ENTRY0, FMT);
+    PRINTFLAG(DSU->ENTRY0, EPRES);
+    PRINTNL();
+    PRINTRAW(DSU->ENTRY1.reg);
+    opts.print.print("ENTRY1:  ");
+    PRINTHEX(DSU->ENTRY1.reg);
+    PRINTNL();
+    if (DSU->ENTRY0.bit.EPRES) {
+        printFourRegDSU_ROMTABLE(opts, dsuTable + (DSU->ENTRY0.reg & 0xFFFFF000));
+    }
+}
+
 void printFourRegEIC_SENSE(FourRegOptions &opts, uint8_t sense) {
     switch (sense) {
         case 0x0: opts.print.print("none"); break;
@@ -849,9 +1962,23 @@ void printFourRegEIC(FourRegOptions &opts) {
         if (EIC->EVCTRL.bit.EXTINTEO & (1 << id)) {
             opts.print.print(" EXTINTEO");
         }
+#ifdef PINS_COUNT
+        // board pins currently muxed to this interrupt, as one "arduino=D2,D9" field
+        bool first = true;
+        for (uint8_t gid = 0; gid < fourRegsPORTGroups(); gid++) {
+            for (uint8_t pid = 0; pid < 32; pid++) {
+                if (fourRegsPORT_extint(gid, pid) == id && fourRegsPORT_pmux(gid, pid) == 0x0) {
+                    if (printFourReg_ARDUINO(opts, gid, pid, first ? " arduino=D" : ",D")) {
+                        first = false;
+                    }
+                }
+            }
+        }
+#endif
         PRINTNL();
     }
 
+    PRINTRAW(EIC->DPRESCALER.reg);
     opts.print.print("DPRESCALER: ");
     PRINTFLAG(EIC->DPRESCALER, TICKON);
     opts.print.print(" PRESCALER0=");
@@ -1002,6 +2129,8 @@ static const char* FourRegsEVSYS_EVGENs[] = {
     FourRegsEVSYS_EVGEN60, FourRegsEVSYS_EVGEN61, FourRegsEVSYS_EVGEN62, FourRegsEVSYS_EVGEN63, FourRegsEVSYS_EVGEN64, FourRegsEVSYS_EVGEN65, FourRegsEVSYS_EVGEN66, FourRegsEVSYS_EVGEN67,
     FourRegsEVSYS_EVGEN68, FourRegsEVSYS_EVGEN69, FourRegsEVSYS_EVGEN6A, FourRegsEVSYS_EVGEN6B, FourRegsEVSYS_EVGEN6C, FourRegsEVSYS_EVGEN6D, FourRegsEVSYS_EVGEN6E, FourRegsEVSYS_EVGEN6F,
     FourRegsEVSYS_EVGEN70, FourRegsEVSYS_EVGEN71, FourRegsEVSYS_EVGEN72, FourRegsEVSYS_EVGEN73, FourRegsEVSYS_EVGEN74, FourRegsEVSYS_EVGEN75, FourRegsEVSYS_EVGEN76, FourRegsEVSYS_EVGEN77,
+    // EVGEN is 7 bits
+    FourRegs__RESERVED,    FourRegs__RESERVED,    FourRegs__RESERVED,    FourRegs__RESERVED,    FourRegs__RESERVED,    FourRegs__RESERVED,    FourRegs__RESERVED,    FourRegs__RESERVED,
 };
 
 // table 31-2 (datasheet rev E)
@@ -1084,10 +2213,70 @@ static const char* const FourRegsEVSYS_USERs[] = {
     FourRegsEVSYS_USER64, FourRegsEVSYS_USER65, FourRegsEVSYS_USER66,
 };
 
+// GCLK peripheral channel of each event user (table 14-9 datasheet rev E)
+#define FourRegsEVSYS_MCLK 0xFE
+#define FourRegsEVSYS_NOCLK 0xFF
+static const uint8_t FourRegsEVSYS_USER_PCHs[67] = {
+    FourRegsEVSYS_NOCLK,                                                            // RTC
+    FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK, // PORT
+    FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK, // DMAC
+    FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK,
+    FourRegsEVSYS_NOCLK,
+    FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK, FourRegsEVSYS_MCLK,                     // CM4
+    25, 25, 25, 25, 25, 25, 25, 25,                                                 // TCC0
+    25, 25, 25, 25, 25, 25,                                                         // TCC1
+    29, 29, 29, 29, 29,                                                             // TCC2
+    29, 29, 29, 29,                                                                 // TCC3
+    38, 38, 38, 38,                                                                 // TCC4
+    9, 9, 26, 26, 30, 30, 39, 39,                                                   // TC
+    31, 31, 31,                                                                     // PDEC
+    40, 40, 41, 41,                                                                 // ADC
+    32, 32,                                                                         // AC
+    42, 42,                                                                         // DAC
+    33, 33, 33, 33,                                                                 // CCL
+};
+
+// Worst-case nanoseconds from generator to the slowest user of the channel, 0 if unknown.
+// SYNC takes one channel clock, RESYNC up to three (section 31.6.2.6 datasheet rev E).
+// An ASYNC event is synchronized by the user itself, which takes up to three user clocks.
+// Otherwise the user needs one of its own clocks to detect the event.
+uint32_t fourRegsEVSYSLatencyNs(uint8_t chid) {
+    uint8_t path = EVSYS->Channel[chid].CHANNEL.bit.PATH;
+    float ns = 0;
+    if (path != 0x2) {
+        uint32_t hz = (chid < 12) ? fourRegsChannelHz(11 + chid) : 0;
+        if (!hz) {
+            return 0;
+        }
+        ns = ((path == 0x1) ? 3 : 1) * 1e9 / hz;
+    }
+    float worst = 0;
+    for (uint8_t user = 0; user < 67; user++) {
+        if (EVSYS->USER[user].bit.CHANNEL != chid + 1) {
+            continue;
+        }
+        uint32_t hz = 0;
+        switch (FourRegsEVSYS_USER_PCHs[user]) {
+            case FourRegsEVSYS_NOCLK: break;
+            case FourRegsEVSYS_MCLK:  hz = fourRegsGeneratorHz(0) / (MCLK->CPUDIV.reg ? MCLK->CPUDIV.reg : 1); break;
+            default:                  hz = fourRegsChannelHz(FourRegsEVSYS_USER_PCHs[user]); break;
+        }
+        if (!hz) {
+            return 0;
+        }
+        float userns = ((path == 0x2) ? 3 : 1) * 1e9 / hz;
+        if (userns > worst) {
+            worst = userns;
+        }
+    }
+    return (uint32_t) (ns + worst + 0.999);
+}
+
 void printFourRegEVSYS(FourRegOptions &opts) {
     uint8_t id;
     opts.print.println("--------------------------- EVSYS");
 
+    PRINTRAW(EVSYS->PRICTRL.reg);
     opts.print.print("PRICTRL: ");
     PRINTFLAG(EVSYS->PRICTRL, RREN);
     PRINTNL();
@@ -1101,7 +2290,7 @@ void printFourRegEVSYS(FourRegOptions &opts) {
         }
         opts.print.print("CHANNEL");
         PRINTPAD2(id);
-        opts.print.print(":  ");
+        opts.print.print(":  evgen=");
         opts.print.print(FourRegsEVSYS_EVGENs[EVSYS->Channel[id].CHANNEL.bit.EVGEN]);
         opts.print.print(" path=");
         switch (EVSYS->Channel[id].CHANNEL.bit.PATH) {
@@ -1112,40 +2301,107 @@ void printFourRegEVSYS(FourRegOptions &opts) {
         }
         PRINTFLAG(EVSYS->Channel[id].CHANNEL, RUNSTDBY);
         PRINTFLAG(EVSYS->Channel[id].CHANNEL, ONDEMAND);
+        opts.print.print(" latency<=");
+        uint32_t ns = fourRegsEVSYSLatencyNs(id);
+        if (ns) {
+            opts.print.print(ns);
+            opts.print.print("ns");
+        } else {
+            opts.print.print("?");
+        }
         PRINTNL();
     }
 
     for (id = 0; id < 67; id++) {
+        // USER.CHANNEL is the channel number plus one, zero means not connected.
+        // The field is 6 bits but there are only 32 channels.
         uint8_t chid = EVSYS->USER[id].bit.CHANNEL;
-        if ((EVSYS->Channel[chid].CHANNEL.bit.EVGEN == 0) && !opts.showDisabled) {
+        bool routed = chid && chid <= 32 && EVSYS->Channel[chid - 1].CHANNEL.bit.EVGEN;
+        if (!routed && !opts.showDisabled) {
             continue;
         }
         opts.print.print("USER");
         PRINTPAD2(id);
-        opts.print.print(":  ");
+        opts.print.print(":  user=");
         opts.print.print(FourRegsEVSYS_USERs[id]);
         if (FourRegsEVSYS_USERs[id] == FourRegs__RESERVED) {
             PRINTNL();
             continue;
         }
         opts.print.print(" CHANNEL=");
-        opts.print.print(chid - 1);
+        if (chid > 32) {
+            opts.print.print(FourRegs__RESERVED);
+        } else if (chid) {
+            opts.print.print(chid - 1);
+        } else {
+            opts.print.print("none");
+        }
         PRINTNL();
     }
 }
 
+void printFourRegEVSYSGraph(FourRegOptions &opts) {
+    // the path decides the latency, so each gets its own style
+    opts.print.println("digraph EVSYS {");
+    opts.print.println("    rankdir=LR;");
+    for (uint8_t id = 0; id < 32; id++) {
+        EVSYS_CHANNEL_Type channel;
+        COPYVOL(channel, EVSYS->Channel[id].CHANNEL);
+        if (!channel.bit.EVGEN || FourRegsEVSYS_EVGENs[channel.bit.EVGEN] == FourRegs__RESERVED) {
+            continue;
+        }
+        const char* style;
+        opts.print.print("    \"CHANNEL");
+        PRINTPAD2(id);
+        opts.print.print("\" [shape=box,label=\"CHANNEL");
+        PRINTPAD2(id);
+        opts.print.print("\\n");
+        switch (channel.bit.PATH) {
+            case 0x0: opts.print.print("SYNC"); style = "solid"; break;
+            case 0x1: opts.print.print("RESYNC"); style = "dashed"; break;
+            case 0x2: opts.print.print("ASYNC"); style = "bold"; break;
+            default:  opts.print.print(FourRegs__UNKNOWN); style = "dotted"; break;
+        }
+        opts.print.println("\"];");
+
+        opts.print.print("    \"");
+        opts.print.print(FourRegsEVSYS_EVGENs[channel.bit.EVGEN]);
+        opts.print.print("\" -> \"CHANNEL");
+        PRINTPAD2(id);
+        opts.print.print("\" [style=");
+        opts.print.print(style);
+        opts.print.println("];");
+
+        for (uint8_t user = 0; user < 67; user++) {
+            if (EVSYS->USER[user].bit.CHANNEL != id + 1 || FourRegsEVSYS_USERs[user] == FourRegs__RESERVED) {
+                continue;
+            }
+            opts.print.print("    \"CHANNEL");
+            PRINTPAD2(id);
+            opts.print.print("\" -> \"");
+            opts.print.print(FourRegsEVSYS_USERs[user]);
+            opts.print.print("\" [style=");
+            opts.print.print(style);
+            opts.print.println("];");
+        }
+    }
+    opts.print.println("}");
+}
+
 
 void printFourRegFREQM(FourRegOptions &opts) {
     while (FREQM->SYNCBUSY.bit.ENABLE) {}
     if (!FREQM->CTRLA.bit.ENABLE && !opts.showDisabled) {
         return;
     }
-    opts.print.println("--------------------------- EVSYS");
+    opts.print.println("--------------------------- FREQM");
 
+    PRINTRAW(FREQM->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(FREQM->CTRLA, ENABLE);
     PRINTNL();
 
+    PRINTRAW(FREQM->CFGA.reg);
     opts.print.print("CFGA:  REFNUM=");
     PRINTHEX(FREQM->CFGA.bit.REFNUM);
     PRINTNL();
@@ -1236,6 +2492,7 @@ void printFourRegGCLK(FourRegOptions &opts) {
         if (!gen.bit.GENEN && !opts.showDisabled) {
             continue;
         }
+        PRINTRAW(gen.reg);
         opts.print.print("GEN");
         PRINTPAD2(genid);
         opts.print.print(":  ");
@@ -1243,8 +2500,9 @@ void printFourRegGCLK(FourRegOptions &opts) {
             opts.print.println(FourRegs__DISABLED);
             continue;
         }
+        opts.print.print("src=");
         opts.print.print(FourRegsGCLK_SRCs[gen.bit.SRC]);
-        opts.print.print("/");
+        opts.print.print(" div=");
         if (gen.bit.DIVSEL) {
             PRINTSCALE(gen.bit.DIV + 1);
         } else {
@@ -1254,6 +2512,8 @@ void printFourRegGCLK(FourRegOptions &opts) {
                 opts.print.print(1);
             }
         }
+        opts.print.print(" hz=");
+        printFourReg_HZ(opts, fourRegsGeneratorHz(genid));
         PRINTFLAG(gen, IDC);
         if (gen.bit.SRC != 2) {
             PRINTFLAG(gen, OE);
@@ -1263,7 +2523,7 @@ void printFourRegGCLK(FourRegOptions &opts) {
         PRINTFLAG(gen, RUNSTDBY);
         PRINTNL();
     }
-    opts.print.println("GCLK_MAIN:  GEN00 (always)");
+    opts.print.println("GCLK_MAIN:  gen=GEN00");
     for (uint8_t pchid = 1; pchid < 48; pchid++) {
         GCLK_PCHCTRL_Type pch;
         while (GCLK->SYNCBUSY.reg) {}
@@ -1271,11 +2531,12 @@ void printFourRegGCLK(FourRegOptions &opts) {
         if (!pch.bit.CHEN && !opts.showDisabled) {
             continue;
         }
+        PRINTRAW(pch.reg);
         opts.print.print("GCLK_");
         opts.print.print(FourRegsGCLK_CHANs[pchid]);
         opts.print.print(": ");
         if (pch.bit.CHEN) {
-            opts.print.print(" GEN");
+            opts.print.print(" gen=GEN");
             PRINTPAD2(pch.bit.GEN);
             PRINTFLAG(pch, WRTLOCK);
             PRINTNL();
@@ -1287,6 +2548,80 @@ void printFourRegGCLK(FourRegOptions &opts) {
 }
 
 
+// Bus matrix master and slave IDs (datasheet rev E, "Bus Matrix Masters" and
+// "Bus Matrix Slaves" tables).  The CMSIS headers don't name them.
+struct FourRegsHMATRIX_Name {
+    uint8_t     id;
+    const char* name;
+};
+static const FourRegsHMATRIX_Name FourRegsHMATRIX_MASTERs[] = {
+    { 0, "CPU" },
+    { 1, "CMCC" },
+    { 2, "DSU" },
+    { 3, "DMAC" },
+    { 4, "USB" },
+    { 5, "ICM" },
+    { 6, "SDHC0" },
+    { 7, "SDHC1" },
+    { 8, "PUKCC" },
+    { 0xFF, NULL },
+};
+static const FourRegsHMATRIX_Name FourRegsHMATRIX_SLAVEs[] = {
+    { 0, "FLASH" },
+    { 1, "FLASH_ALT" },
+    { 2, "SEEPROM" },
+    { 3, "QSPI" },
+    { 4, "HPB0" },
+    { 5, "HPB1" },
+    { 6, "HPB2" },
+    { 7, "HPB3" },
+    { 8, "SDHC0" },
+    { 9, "SDHC1" },
+    { 10, "BKUPRAM" },
+    { 0xFF, NULL },
+};
+
+void printFourRegHMATRIX_NAME(FourRegOptions &opts, const FourRegsHMATRIX_Name* names, char prefix, uint8_t id) {
+    for (; names->name; names++) {
+        if (names->id == id) {
+            opts.print.print(names->name);
+            return;
+        }
+    }
+    opts.print.print(prefix);
+    opts.print.print(id);
+}
+
+void printFourRegHMATRIX(FourRegOptions &opts) {
+    opts.print.println("--------------------------- HMATRIX");
+
+    // Each slave has a 4-bit priority for each master, PRAS for masters 0-7
+    // and PRBS for masters 8-15.  Higher wins when masters collide.
+    for (uint8_t slave = 0; slave < 16; slave++) {
+        uint32_t pras = HMATRIX->Prs[slave].PRAS.reg;
+        uint32_t prbs = HMATRIX->Prs[slave].PRBS.reg;
+        if (!pras && !prbs && !opts.showDisabled) {
+            continue;
+        }
+        opts.print.print("PRS");
+        PRINTPAD2(slave);
+        opts.print.print(":  slave=");
+        printFourRegHMATRIX_NAME(opts, FourRegsHMATRIX_SLAVEs, 'S', slave);
+        for (uint8_t master = 0; master < 16; master++) {
+            uint8_t pri = 0xF & (((master < 8) ? pras : prbs) >> (4 * (master % 8)));
+            if (!pri) {
+                continue;
+            }
+            opts.print.print(" ");
+            printFourRegHMATRIX_NAME(opts, FourRegsHMATRIX_MASTERs, 'M', master);
+            opts.print.print("=");
+            opts.print.print(pri);
+        }
+        PRINTNL();
+    }
+}
+
+
 #ifdef I2S
 void printFourRegI2S(FourRegOptions &opts) {
     while (I2S->SYNCBUSY.bit.ENABLE) {}
@@ -1295,8 +2630,9 @@ void printFourRegI2S(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- I2S");
 
-    opts.print.print("CTRLA: ");
     while (I2S->SYNCBUSY.bit.ENABLE) {}
+    PRINTRAW(I2S->CTRLA.reg);
+    opts.print.print("CTRLA: ");
     PRINTFLAG(I2S->CTRLA, ENABLE);
     while (I2S->SYNCBUSY.bit.CKEN0) {}
     PRINTFLAG(I2S->CTRLA, CKEN0);
@@ -1350,6 +2686,7 @@ void printFourRegI2S(FourRegOptions &opts) {
         PRINTNL();
     }
 
+    PRINTRAW(I2S->TXCTRL.reg);
     opts.print.print("TXCTRL:  txdefault=");
     switch (I2S->TXCTRL.bit.TXDEFAULT) {
         case 0x0: opts.print.print("ZERO"); break;
@@ -1394,6 +2731,7 @@ void printFourRegI2S(FourRegOptions &opts) {
     opts.print.print(I2S->TXCTRL.bit.DMA ? "MULTIPLE" : "SINGLE");
     PRINTNL();
 
+    PRINTRAW(I2S->RXCTRL.reg);
     opts.print.print("RXCTRL:  sermode=");
     switch (I2S->RXCTRL.bit.SERMODE) {
         case 0x0: opts.print.print("RX"); break;
@@ -1447,6 +2785,7 @@ void printFourRegICM(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- ICM");
 
+    PRINTRAW(ICM->CFG.reg);
     opts.print.print("CFG: ");
     PRINTFLAG(ICM->CFG, WBDIS);
     PRINTFLAG(ICM->CFG, EOMDIS);
@@ -1470,6 +2809,7 @@ void printFourRegICM(FourRegOptions &opts) {
     PRINTHEX(ICM->CFG.bit.DAPROT);
     PRINTNL();
 
+    PRINTRAW(ICM->CTRL.reg);
     opts.print.print("CTRL: ");
     PRINTFLAG(ICM->CTRL, ENABLE);
     PRINTFLAG(ICM->CTRL, DISABLE);
@@ -1481,6 +2821,7 @@ void printFourRegICM(FourRegOptions &opts) {
     PRINTHEX(ICM->CTRL.bit.RMEN);
     PRINTNL();
 
+    PRINTRAW(ICM->UASR.reg);
     opts.print.print("UASR:  URAT=");
     PRINTHEX(ICM->UASR.bit.URAT);
     PRINTNL();
@@ -1489,13 +2830,16 @@ void printFourRegICM(FourRegOptions &opts) {
 
 void printFourRegMCLK(FourRegOptions &opts) {
     opts.print.println("--------------------------- MCLK");
+    PRINTRAW(MCLK->HSDIV.reg);
     opts.print.print("HSDIV:  /");
     opts.print.print(MCLK->HSDIV.reg);
     PRINTNL();
+    PRINTRAW(MCLK->CPUDIV.reg);
     opts.print.print("CPUDIV:  /");
     opts.print.print(MCLK->CPUDIV.reg);
     PRINTNL();
 
+    PRINTRAW(MCLK->AHBMASK.reg);
     opts.print.print("AHBMASK: ");
     if (MCLK->AHBMASK.bit.HPB0_) { opts.print.print(" HPB0"); }
     if (MCLK->AHBMASK.bit.HPB1_) { opts.print.print(" HPB1"); }
@@ -1513,6 +2857,12 @@ void printFourRegMCLK(FourRegOptions &opts) {
     if (MCLK->AHBMASK.bit.QSPI_) { opts.print.print(" QSPI"); }
     if (MCLK->AHBMASK.bit.SDHC0_) { opts.print.print(" SDHC0"); }
     if (MCLK->AHBMASK.bit.SDHC1_) { opts.print.print(" SDHC1"); }
+#ifdef CAN0
+    if (MCLK->AHBMASK.bit.CAN0_) { opts.print.print(" CAN0"); }
+#endif
+#ifdef CAN1
+    if (MCLK->AHBMASK.bit.CAN1_) { opts.print.print(" CAN1"); }
+#endif
     if (MCLK->AHBMASK.bit.ICM_) { opts.print.print(" ICM"); }
     if (MCLK->AHBMASK.bit.PUKCC_) { opts.print.print(" PUKCC"); }
     if (MCLK->AHBMASK.bit.QSPI_2X_) { opts.print.print(" QSPI_2X"); }
@@ -1520,6 +2870,7 @@ void printFourRegMCLK(FourRegOptions &opts) {
     if (MCLK->AHBMASK.bit.NVMCTRL_CACHE_) { opts.print.print(" NVMCTRL_CACHE"); }
     PRINTNL();
 
+    PRINTRAW(MCLK->APBAMASK.reg);
     opts.print.print("APBAMASK: ");
     if (MCLK->APBAMASK.bit.PAC_) { opts.print.print(" PAC"); }
     if (MCLK->APBAMASK.bit.PM_) { opts.print.print(" PM"); }
@@ -1539,6 +2890,7 @@ void printFourRegMCLK(FourRegOptions &opts) {
     if (MCLK->APBAMASK.bit.TC1_) { opts.print.print(" TC1"); }
     PRINTNL();
 
+    PRINTRAW(MCLK->APBBMASK.reg);
     opts.print.print("APBBMASK: ");
     if (MCLK->APBBMASK.bit.USB_) { opts.print.print(" USB"); }
     if (MCLK->APBBMASK.bit.DSU_) { opts.print.print(" DSU"); }
@@ -1556,6 +2908,7 @@ void printFourRegMCLK(FourRegOptions &opts) {
     if (MCLK->APBBMASK.bit.RAMECC_) { opts.print.print(" RAMECC"); }
     PRINTNL();
 
+    PRINTRAW(MCLK->APBCMASK.reg);
     opts.print.print("APBCMASK: ");
     if (MCLK->APBCMASK.bit.TCC2_) { opts.print.print(" TCC2"); }
     if (MCLK->APBCMASK.bit.TCC3_) { opts.print.print(" TCC3"); }
@@ -1570,6 +2923,7 @@ void printFourRegMCLK(FourRegOptions &opts) {
     if (MCLK->APBCMASK.bit.CCL_) { opts.print.print(" CCL"); }
     PRINTNL();
 
+    PRINTRAW(MCLK->APBDMASK.reg);
     opts.print.print("APBDMASK: ");
     if (MCLK->APBDMASK.bit.SERCOM4_) { opts.print.print(" SERCOM4"); }
     if (MCLK->APBDMASK.bit.SERCOM5_) { opts.print.print(" SERCOM5"); }
@@ -1590,6 +2944,7 @@ void printFourRegMCLK(FourRegOptions &opts) {
 void printFourRegNVMCTRL(FourRegOptions &opts) {
     opts.print.println("--------------------------- NVMCTRL");
 
+    PRINTRAW(NVMCTRL->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(NVMCTRL->CTRLA, AUTOWS);
     PRINTFLAG(NVMCTRL->CTRLA, SUSPEN);
@@ -1615,6 +2970,7 @@ void printFourRegNVMCTRL(FourRegOptions &opts) {
     PRINTFLAG(NVMCTRL->CTRLA, CACHEDIS1);
     PRINTNL();
 
+    PRINTRAW(NVMCTRL->PARAM.reg);
     opts.print.print("PARAM:  NVMP=");
     opts.print.print(NVMCTRL->PARAM.bit.NVMP);
     opts.print.print(" psz=");
@@ -1623,6 +2979,7 @@ void printFourRegNVMCTRL(FourRegOptions &opts) {
     PRINTFLAG(NVMCTRL->PARAM, SEE);
     PRINTNL();
 
+    PRINTRAW(NVMCTRL->STATUS.reg);
     opts.print.print("STATUS: ");
     PRINTFLAG(NVMCTRL->STATUS, AFIRST);
     PRINTFLAG(NVMCTRL->STATUS, BPDIS);
@@ -1631,6 +2988,7 @@ void printFourRegNVMCTRL(FourRegOptions &opts) {
     opts.print.print("kb");
     PRINTNL();
 
+    PRINTRAW(NVMCTRL->RUNLOCK.reg);
     opts.print.print("RUNLOCK:  ");
     for (uint8_t i = 0; i < 32; i++) {
         opts.print.print(
@@ -1641,6 +2999,7 @@ void printFourRegNVMCTRL(FourRegOptions &opts) {
     }
     PRINTNL();
 
+    PRINTRAW(NVMCTRL->SEECFG.reg);
     opts.print.print("SEECFG:  wmode=");
     opts.print.print(
             NVMCTRL->SEECFG.bit.WMODE ?
@@ -1650,6 +3009,7 @@ void printFourRegNVMCTRL(FourRegOptions &opts) {
     PRINTFLAG(NVMCTRL->SEECFG, APRDIS);
     PRINTNL();
 
+    PRINTRAW(NVMCTRL->SEESTAT.reg);
     opts.print.print("SEESTAT:  ASEES=");
     opts.print.print(NVMCTRL->SEESTAT.bit.ASEES);
     PRINTFLAG(NVMCTRL->SEESTAT, LOCK);
@@ -1669,10 +3029,12 @@ void printFourRegNVMCTRL(FourRegOptions &opts) {
 void printFourRegOSC32KCTRL(FourRegOptions &opts) {
     opts.print.println("--------------------------- OSC32KCTRL");
 
+    PRINTRAW(OSC32KCTRL->EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     PRINTFLAG(OSC32KCTRL->EVCTRL, CFDEO);
     PRINTNL();
 
+    PRINTRAW(OSC32KCTRL->RTCCTRL.reg);
     opts.print.print("RTCCTRL:  rtcsel=");
     switch (OSC32KCTRL->RTCCTRL.bit.RTCSEL) {
         case 0x0: opts.print.print("ULP1K"); break;
@@ -1684,6 +3046,7 @@ void printFourRegOSC32KCTRL(FourRegOptions &opts) {
     PRINTNL();
 
     if (OSC32KCTRL->XOSC32K.bit.ENABLE || opts.showDisabled) {
+        PRINTRAW(OSC32KCTRL->XOSC32K.reg);
         opts.print.print("XOSC32K: ");
         PRINTFLAG(OSC32KCTRL->XOSC32K, ENABLE);
         PRINTFLAG(OSC32KCTRL->XOSC32K, XTALEN);
@@ -1705,6 +3068,7 @@ void printFourRegOSC32KCTRL(FourRegOptions &opts) {
     }
 
     if (OSC32KCTRL->CFDCTRL.bit.CFDEN || opts.showDisabled) {
+        PRINTRAW(OSC32KCTRL->CFDCTRL.reg);
         opts.print.print("CFDCTRL: ");
         PRINTFLAG(OSC32KCTRL->CFDCTRL, CFDEN);
         PRINTFLAG(OSC32KCTRL->CFDCTRL, SWBACK);
@@ -1717,6 +3081,7 @@ void printFourRegOSC32KCTRL(FourRegOptions &opts) {
         }
     }
 
+    PRINTRAW(OSC32KCTRL->OSCULP32K.reg);
     opts.print.print("OSCULP32K: ");
     PRINTFLAG(OSC32KCTRL->OSCULP32K, EN32K);
     PRINTFLAG(OSC32KCTRL->OSCULP32K, EN1K);
@@ -1730,6 +3095,7 @@ void printFourRegOSC32KCTRL(FourRegOptions &opts) {
 void printFourRegOSCCTRL(FourRegOptions &opts) {
     opts.print.println("--------------------------- OSCCTRL");
 
+    PRINTRAW(OSCCTRL->EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     PRINTFLAG(OSCCTRL->EVCTRL, CFDEO0);
     PRINTFLAG(OSCCTRL->EVCTRL, CFDEO1);
@@ -1739,17 +3105,19 @@ void printFourRegOSCCTRL(FourRegOptions &opts) {
     while (OSCCTRL->DFLLSYNC.bit.ENABLE) {}
     COPYVOL(ctrla, OSCCTRL->DFLLCTRLA);
     if (ctrla.bit.ENABLE || opts.showDisabled) {
+        PRINTRAW(ctrla.reg);
         opts.print.print("DFLLCTRLA: ");
         PRINTFLAG(ctrla, ENABLE);
         PRINTFLAG(ctrla, RUNSTDBY);
         PRINTFLAG(ctrla, ONDEMAND);
         PRINTNL();
 
-        opts.print.print("DFLLCTRLB: ");
         OSCCTRL_DFLLCTRLB_Type ctrlb;
         while (OSCCTRL->DFLLSYNC.bit.DFLLCTRLB) {}
         COPYVOL(ctrlb, OSCCTRL->DFLLCTRLB);
-        opts.print.print(ctrlb.bit.MODE ? " closed-loop" : " open-loop");
+        PRINTRAW(ctrlb.reg);
+        opts.print.print("DFLLCTRLB: ");
+        opts.print.print(ctrlb.bit.MODE ? " mode=closed-loop" : " mode=open-loop");
         PRINTFLAG(ctrlb, STABLE);
         PRINTFLAG(ctrlb, LLAW);
         PRINTFLAG(ctrlb, USBCRM);
@@ -1791,6 +3159,7 @@ void printFourRegOSCCTRL(FourRegOptions &opts) {
 
     for (uint8_t xoscid = 0; xoscid < 2; xoscid++) {
         if (OSCCTRL->XOSCCTRL[xoscid].bit.ENABLE || opts.showDisabled) {
+            PRINTRAW(OSCCTRL->XOSCCTRL[xoscid].reg);
             opts.print.print("XOSCCTRL");
             opts.print.print(xoscid);
             opts.print.print(": ");
@@ -1828,7 +3197,6 @@ void printFourRegOSCCTRL(FourRegOptions &opts) {
             PRINTFLAG(OSCCTRL->Dpll[dpllid].DPLLCTRLA, ENABLE);
             PRINTFLAG(OSCCTRL->Dpll[dpllid].DPLLCTRLA, RUNSTDBY);
             PRINTFLAG(OSCCTRL->Dpll[dpllid].DPLLCTRLA, ONDEMAND);
-            //FUTURE -- calculate actual clock speed [out = REFCLK * (LDR+1+(LDRFRAC/32))]
             uint8_t refclk = OSCCTRL->Dpll[dpllid].DPLLCTRLB.bit.REFCLK;
             opts.print.print(" refclk=");
             switch (refclk) {
@@ -1840,11 +3208,11 @@ void printFourRegOSCCTRL(FourRegOptions &opts) {
                 case 0x1: opts.print.print("XOSC32"); break;
                 case 0x2:
                           opts.print.print("XOSC0/");
-                          PRINTSCALE(OSCCTRL->Dpll[dpllid].DPLLCTRLB.bit.DIV + 1);
+                          opts.print.print(2 * (OSCCTRL->Dpll[dpllid].DPLLCTRLB.bit.DIV + 1));
                           break;
                 case 0x3:
                           opts.print.print("XOSC1/");
-                          PRINTSCALE(OSCCTRL->Dpll[dpllid].DPLLCTRLB.bit.DIV + 1);
+                          opts.print.print(2 * (OSCCTRL->Dpll[dpllid].DPLLCTRLB.bit.DIV + 1));
                           break;
                 default: opts.print.print(FourRegs__RESERVED); break;
             }
@@ -1852,6 +3220,8 @@ void printFourRegOSCCTRL(FourRegOptions &opts) {
             opts.print.print(OSCCTRL->Dpll[dpllid].DPLLRATIO.bit.LDR);
             opts.print.print(".");
             opts.print.print(OSCCTRL->Dpll[dpllid].DPLLRATIO.bit.LDRFRAC);
+            opts.print.print(" hz=");
+            printFourReg_HZ(opts, fourRegsDPLLHz(dpllid));
             opts.print.print(" FILTER=");
             PRINTHEX(OSCCTRL->Dpll[dpllid].DPLLCTRLB.bit.FILTER);
             PRINTFLAG(OSCCTRL->Dpll[dpllid].DPLLCTRLB, WUF);
@@ -1886,10 +3256,12 @@ void printFourRegPAC(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- PAC");
 
+    PRINTRAW(PAC->EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     PRINTFLAG(PAC->EVCTRL, ERREO);
     PRINTNL();
 
+    PRINTRAW(PAC->STATUSA.reg);
     opts.print.print("STATUSA: ");
     if (PAC->STATUSA.bit.PAC_) { opts.print.print(" PAC"); }
     if (PAC->STATUSA.bit.PM_) { opts.print.print(" PM"); }
@@ -1909,6 +3281,7 @@ void printFourRegPAC(FourRegOptions &opts) {
     if (PAC->STATUSA.bit.TC1_) { opts.print.print(" TC1"); }
     PRINTNL();
 
+    PRINTRAW(PAC->STATUSB.reg);
     opts.print.print("STATUSB: ");
     if (PAC->STATUSB.bit.USB_) { opts.print.print(" USB"); }
     if (PAC->STATUSB.bit.DSU_) { opts.print.print(" DSU"); }
@@ -1928,6 +3301,7 @@ void printFourRegPAC(FourRegOptions &opts) {
     if (PAC->STATUSB.bit.RAMECC_) { opts.print.print(" RAMECC"); }
     PRINTNL();
 
+    PRINTRAW(PAC->STATUSC.reg);
     opts.print.print("STATUSC: ");
     if (PAC->STATUSC.bit.TCC2_) { opts.print.print(" TCC2"); }
     if (PAC->STATUSC.bit.TCC3_) { opts.print.print(" TCC3"); }
@@ -1943,6 +3317,7 @@ void printFourRegPAC(FourRegOptions &opts) {
     if (PAC->STATUSC.bit.CCL_) { opts.print.print(" CCL"); }
     PRINTNL();
 
+    PRINTRAW(PAC->STATUSD.reg);
     opts.print.print("STATUSD: ");
     if (PAC->STATUSD.bit.SERCOM4_) { opts.print.print(" SERCOM4"); }
     if (PAC->STATUSD.bit.SERCOM5_) { opts.print.print(" SERCOM5"); }
@@ -1966,6 +3341,7 @@ void printFourRegPCC(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- PCC");
 
+    PRINTRAW(PCC->MR.reg);
     opts.print.print("MR: ");
     PRINTFLAG(PCC->MR, PCEN);
     opts.print.print(" DSIZE=");
@@ -1994,8 +3370,9 @@ void printFourRegPDEC(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- PDEC");
 
-    opts.print.print("CTRLA: ");
     while (PDEC->SYNCBUSY.bit.ENABLE) {}
+    PRINTRAW(PDEC->CTRLA.reg);
+    opts.print.print("CTRLA: ");
     PRINTFLAG(PDEC->CTRLA, ENABLE);
     opts.print.print(" mode=");
     switch (PDEC->CTRLA.bit.MODE) {
@@ -2026,6 +3403,7 @@ void printFourRegPDEC(FourRegOptions &opts) {
     PRINTHEX(PDEC->CTRLA.bit.ANGULAR);
     PRINTNL();
 
+    PRINTRAW(PDEC->EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     if (PDEC->CTRLA.bit.MODE == PDEC_CTRLA_MODE_COUNTER_Val) {
         opts.print.print(" evact=");
@@ -2058,6 +3436,7 @@ void printFourRegPDEC(FourRegOptions &opts) {
     PRINTNL();
 
     while (PDEC->SYNCBUSY.bit.PRESC) {}
+    PRINTRAW(PDEC->PRESC.reg);
     opts.print.print("PRESC:  ");
     if (PDEC->PRESC.bit.PRESC <= 10) {
         opts.print.print("DIV");
@@ -2069,6 +3448,7 @@ void printFourRegPDEC(FourRegOptions &opts) {
 
     if (PDEC->CTRLA.bit.MODE != PDEC_CTRLA_MODE_COUNTER_Val) {
         while (PDEC->SYNCBUSY.bit.FILTER) {}
+        PRINTRAW(PDEC->FILTER.reg);
         opts.print.print("FILTER:  ");
         opts.print.print(PDEC->FILTER.bit.FILTER);
         PRINTNL();
@@ -2097,10 +3477,12 @@ void printFourRegPM_CFG(FourRegOptions &opts, uint8_t v) {
 void printFourRegPM(FourRegOptions &opts) {
     opts.print.println("--------------------------- PM");
 
+    PRINTRAW(PM->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(PM->CTRLA, IORET);
     PRINTNL();
 
+    PRINTRAW(PM->HIBCFG.reg);
     opts.print.print("HIBCFG: ");
     opts.print.print(" ramcfg=");
     printFourRegPM_CFG(opts, PM->HIBCFG.bit.RAMCFG);
@@ -2108,6 +3490,7 @@ void printFourRegPM(FourRegOptions &opts) {
     printFourRegPM_CFG(opts, PM->HIBCFG.bit.BRAMCFG);
     PRINTNL();
 
+    PRINTRAW(PM->STDBYCFG.reg);
     opts.print.print("STDBYCFG: ");
     opts.print.print(" ramcfg=");
     printFourRegPM_CFG(opts, PM->STDBYCFG.bit.RAMCFG);
@@ -2115,11 +3498,13 @@ void printFourRegPM(FourRegOptions &opts) {
     PRINTHEX(PM->STDBYCFG.bit.FASTWKUP);
     PRINTNL();
 
+    PRINTRAW(PM->BKUPCFG.reg);
     opts.print.print("BKUPCFG: ");
     opts.print.print(" bramcfg=");
     printFourRegPM_CFG(opts, PM->BKUPCFG.bit.BRAMCFG);
     PRINTNL();
 
+    PRINTRAW(PM->PWSAKDLY.reg);
     opts.print.print("PWSAKDLY: ");
     PRINTFLAG(PM->PWSAKDLY, IGNACK);
     opts.print.print(" DLYVAL=");
@@ -2294,7 +3679,8 @@ static const FourRegsPORT_Pin FourRegsPORT_pins[4][32] = {
 };
 
 void printFourRegPORT(FourRegOptions &opts) {
-    for (uint8_t gid = 0; gid < 4; gid++) {
+    fourRegsSERCOM_loadPads();
+    for (uint8_t gid = 0; gid < fourRegsPORTGroups(); gid++) {
         opts.print.print("--------------------------- PORT ");
         opts.print.print(char('A' + gid));
         PRINTNL();
@@ -2321,31 +3707,34 @@ void printFourRegPORT(FourRegOptions &opts) {
                 } else {
                     pmux = PORT->Group[gid].PMUX[pid/2].bit.PMUXO;
                 }
-                opts.print.print("pmux ");
-                const char *pmuxName = FourRegsPORT_pins[gid][pid].pmux[pmux];
+                opts.print.print("pmux=");
+                const char *pmuxName = fourRegsPORT_func(gid, pid, pmux);
                 if (pmuxName) {
                     opts.print.print(pmuxName);
                     if (pmux == 2 || pmux == 3) {
                         printFourRegSERCOM_pinhint(opts, pmuxName);
                     }
-                } else {
+                } else if (pmux < 14) {
                     opts.print.print(FourRegsPORT_PMUXs[pmux].name);
+                } else {
+                    opts.print.print(FourRegs__RESERVED);
                 }
                 if (!dir && !inen && !pullen) {
                     // [32.6.3.4] Digital Functionality Disabled
+                    printFourReg_ARDUINO(opts, gid, pid);
                     PRINTNL();
                     continue;
                 }
                 opts.print.print(" ");
             }
             if (dir) {
-                opts.print.print("output");
+                opts.print.print("dir=output");
                 if (inen) {
                     opts.print.print(" INEN");
                 }
                 PRINTFLAG(PORT->Group[gid].PINCFG[pid], DRVSTR);
             } else {
-                opts.print.print("input");
+                opts.print.print("dir=input");
                 if (inen) {
                     opts.print.print(" INEN");
                 }
@@ -2360,12 +3749,13 @@ void printFourRegPORT(FourRegOptions &opts) {
                             );
                 }
             }
+            printFourReg_ARDUINO(opts, gid, pid);
             PRINTNL();
         }
 
         opts.print.print("EVCTRL: ");
         if (PORT->Group[gid].EVCTRL.bit.PORTEI0 || opts.showDisabled) {
-            opts.print.print(" evt0:");
+            opts.print.print(" evt0=");
             if (PORT->Group[gid].EVCTRL.bit.PORTEI0) {
                 opts.print.print("PORTEI0,");
             }
@@ -2412,21 +3802,176 @@ void printFourRegPORT(FourRegOptions &opts) {
         }
         PRINTNL();
     }
-    //FUTURE -- walk Arduino g_APinDescription (see WVariant.h)
 }
 
 
+// Selected PMUX of a pin, 0xFF if it isn't muxed to a peripheral.  PMUX 14
+// and 15 are reserved, so use fourRegsPORT_func() rather than indexing pmux[].
+uint8_t fourRegsPORT_pmux(uint8_t gid, uint8_t pid) {
+    if (!FourRegsPORT_pins[gid][pid].name || !PORT->Group[gid].PINCFG[pid].bit.PMUXEN) {
+        return 0xFF;
+    }
+    if ((pid%2) == 0) {
+        return PORT->Group[gid].PMUX[pid/2].bit.PMUXE;
+    } else {
+        return PORT->Group[gid].PMUX[pid/2].bit.PMUXO;
+    }
+}
+
+// Function of a pin for a PMUX (such as "TCC0:4"), NULL if it has none.
+const char* fourRegsPORT_func(uint8_t gid, uint8_t pid, uint8_t sel) {
+    if (sel >= 14) {
+        return NULL;
+    }
+    return FourRegsPORT_pins[gid][pid].pmux[sel];
+}
+
+// EXTINT of a pin (from its "EIC:n" PMUX A function), 0xFF for none or NMI
+uint8_t fourRegsPORT_extint(uint8_t gid, uint8_t pid) {
+    const char* func = FourRegsPORT_pins[gid][pid].pmux[0];
+    if (!func || !isdigit(func[4])) {
+        return 0xFF;
+    }
+    return atoi(func + 4);
+}
+
+// Whether the peripheral of a PMUX function (such as "TCC0:4") is known to be disabled.
+// Peripherals this doesn't know about are assumed to be enabled.
+bool fourRegsPORT_isDisabled(const char* func) {
+    if (strncmp(func, "SERCOM", 6) == 0) {
+        Sercom* sercom = fourRegsSERCOM(func[6] - '0');
+        return !sercom || !sercom->I2CM.CTRLA.bit.ENABLE;
+    }
+    if (strncmp(func, "TCC", 3) == 0) {
+        Tcc* tcc = fourRegsTCC(func[3] - '0');
+        return !tcc || !tcc->CTRLA.bit.ENABLE;
+    }
+    if (strncmp(func, "TC", 2) == 0) {
+        Tc* tc = fourRegsTC(func[2] - '0');
+        return !tc || !tc->COUNT8.CTRLA.bit.ENABLE;
+    }
+    if (strncmp(func, "GCLK:", 5) == 0) {
+        uint8_t genid = func[5] - '0';
+        return !GCLK->GENCTRL[genid].bit.GENEN || !GCLK->GENCTRL[genid].bit.OE;
+    }
+    if (strcmp(func, "EIC:NMI") == 0)   { return !EIC->NMICTRL.bit.NMISENSE; }    // NMICTRL isn't gated by CTRLA.ENABLE
+    if (strncmp(func, "EIC:", 4) == 0)  { return !EIC->CTRLA.bit.ENABLE; }
+    if (strncmp(func, "AC:", 3) == 0)   { return !AC->CTRLA.bit.ENABLE; }
+    if (strncmp(func, "CCL:", 4) == 0)  { return !CCL->CTRL.bit.ENABLE; }
+    if (strncmp(func, "PDEC:", 5) == 0) { return !PDEC->CTRLA.bit.ENABLE; }
+    if (strncmp(func, "QSPI:", 5) == 0) { return !QSPI->CTRLA.bit.ENABLE; }
+    if (strncmp(func, "USB:", 4) == 0)  { return !USB->DEVICE.CTRLA.bit.ENABLE; }
+#ifdef I2S
+    if (strncmp(func, "I2S:", 4) == 0)  { return !I2S->CTRLA.bit.ENABLE; }
+#endif
+    return false;
+}
+
+void printFourRegPORTMatrix(FourRegOptions &opts) {
+    fourRegsSERCOM_loadPads();
+    // read the PMUX of every pin once, for the conflict check below
+    uint8_t sels[4][32];
+    for (uint8_t gid = 0; gid < fourRegsPORTGroups(); gid++) {
+        for (uint8_t pid = 0; pid < 32; pid++) {
+            sels[gid][pid] = fourRegsPORT_pmux(gid, pid);
+        }
+    }
+    for (uint8_t gid = 0; gid < fourRegsPORTGroups(); gid++) {
+        opts.print.print("--------------------------- PORT ");
+        opts.print.print(char('A' + gid));
+        opts.print.println(" MATRIX");
+        opts.print.print("pmux:  ");
+        for (uint8_t pmux = 0; pmux < 14; pmux++) {
+            opts.print.print(FourRegsPORT_PMUXs[pmux].id);
+        }
+        PRINTNL();
+
+        for (uint8_t pid = 0; pid < 32; pid++) {
+            const FourRegsPORT_Pin &pin = FourRegsPORT_pins[gid][pid];
+            if (!pin.name) {
+                continue;
+            }
+            bool dir = PORT->Group[gid].DIR.bit.DIR & (1 << pid);
+            bool inen = PORT->Group[gid].PINCFG[pid].bit.INEN;
+            uint8_t sel = sels[gid][pid];
+            const char* func = fourRegsPORT_func(gid, pid, sel);
+            if (!dir && !inen && sel == 0xFF && !opts.showDisabled) {
+                continue;
+            }
+
+            // Another pin muxed to the same function.  The analog functions
+            // (column B) are left out since several can share an input.
+            const char* dup = NULL;
+            if (func && sel != 0x1) {
+                for (uint8_t ogid = 0; ogid < fourRegsPORTGroups() && !dup; ogid++) {
+                    for (uint8_t opid = 0; opid < 32; opid++) {
+                        uint8_t osel = sels[ogid][opid];
+                        if ((ogid == gid && opid == pid) || osel == 0x1) {
+                            continue;
+                        }
+                        const char* ofunc = fourRegsPORT_func(ogid, opid, osel);
+                        if (ofunc && strcmp(func, ofunc) == 0) {
+                            dup = FourRegsPORT_pins[ogid][opid].name;
+                            break;
+                        }
+                    }
+                }
+            }
+            bool disabled = func && sel != 0x1 && fourRegsPORT_isDisabled(func);
+            bool norole = func && (sel == 0x2 || sel == 0x3) && !disabled && !fourRegsSERCOM_padRole(func);
+
+            opts.print.print(pin.name);
+            opts.print.print(":  map=");
+            for (uint8_t pmux = 0; pmux < 14; pmux++) {
+                if (pmux == sel) {
+                    opts.print.print((dup || disabled || norole) ? '!' : '*');
+                } else {
+                    opts.print.print(pin.pmux[pmux] ? 'o' : '.');
+                }
+            }
+            opts.print.print(dir ? " dir=out" : (inen ? " dir=in" : " dir=off"));
+            if (sel != 0xFF) {
+                opts.print.print(" func=");
+                if (func) {
+                    opts.print.print(func);
+                    if (sel == 0x2 || sel == 0x3) {
+                        printFourRegSERCOM_pinhint(opts, func);
+                    }
+                } else if (sel < 14) {
+                    opts.print.print(FourRegsPORT_PMUXs[sel].name);
+                } else {
+                    opts.print.print(FourRegs__RESERVED);
+                }
+            }
+            if (dup) {
+                opts.print.print(" conflict=");
+                opts.print.print(dup);
+            }
+            if (disabled) {
+                opts.print.print(" DISABLED");
+            }
+            if (norole) {
+                opts.print.print(" NOROLE");
+            }
+            printFourReg_ARDUINO(opts, gid, pid);
+            PRINTNL();
+        }
+    }
+}
+
 void printFourRegQSPI(FourRegOptions &opts) {
     if (!QSPI->STATUS.bit.ENABLE && !opts.showDisabled) {
         return;
     }
     opts.print.println("--------------------------- QSPI");
 
+    PRINTRAW(QSPI->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(QSPI->CTRLA, ENABLE);
     PRINTFLAG(QSPI->CTRLA, LASTXFER);
     PRINTNL();
 
+    PRINTRAW(QSPI->CTRLB.reg);
     opts.print.print("CTRLB:  mode=");
     opts.print.print(QSPI->CTRLB.bit.MODE ? "MEMORY" : "SPI");
     PRINTFLAG(QSPI->CTRLB, LOOPEN);
@@ -2459,6 +4004,7 @@ void printFourRegQSPI(FourRegOptions &opts) {
     opts.print.print(QSPI->CTRLB.bit.DLYCS);
     PRINTNL();
 
+    PRINTRAW(QSPI->BAUD.reg);
     opts.print.print("BAUD:  cpol=");
     opts.print.print(QSPI->BAUD.bit.CPOL ? "HIGH" : "LOW");
     opts.print.print(" cpha=");
@@ -2469,6 +4015,7 @@ void printFourRegQSPI(FourRegOptions &opts) {
     opts.print.print(QSPI->BAUD.bit.DLYBS);
     PRINTNL();
 
+    PRINTRAW(QSPI->INSTRFRAME.reg);
     opts.print.print("INSTRFRAME:  WIDTH=");
     PRINTHEX(QSPI->INSTRFRAME.bit.WIDTH);
     PRINTFLAG(QSPI->INSTRFRAME, INSTREN);
@@ -2497,6 +4044,7 @@ void printFourRegQSPI(FourRegOptions &opts) {
     opts.print.print(QSPI->INSTRFRAME.bit.DUMMYLEN);
     PRINTNL();
 
+    PRINTRAW(QSPI->SCRAMBCTRL.reg);
     opts.print.print("SCRAMBCTRL: ");
     PRINTFLAG(QSPI->SCRAMBCTRL, ENABLE);
     PRINTFLAG(QSPI->SCRAMBCTRL, RANDOMDIS);
@@ -2504,6 +4052,202 @@ void printFourRegQSPI(FourRegOptions &opts) {
 }
 
 
+// ECC error counts kept by fourRegsRAMECCPoll()
+static volatile uint32_t FourRegsRAMECC_totalSingle = 0;
+static volatile uint32_t FourRegsRAMECC_totalDual = 0;
+static volatile uint32_t FourRegsRAMECC_single = 0;
+static volatile uint32_t FourRegsRAMECC_dual = 0;
+static volatile uint32_t FourRegsRAMECC_start = 0;
+static volatile uint32_t FourRegsRAMECC_lastAddr = 0;
+
+void fourRegsRAMECCPoll() {
+    RAMECC_INTFLAG_Type flags;
+    COPYVOL(flags, RAMECC->INTFLAG);
+    if (!flags.reg) {
+        return;
+    }
+    FourRegsRAMECC_lastAddr = RAMECC->ERRADDR.bit.ERRADDR;
+    if (flags.bit.SINGLEE) {
+        FourRegsRAMECC_single++;
+        FourRegsRAMECC_totalSingle++;
+    }
+    if (flags.bit.DUALE) {
+        FourRegsRAMECC_dual++;
+        FourRegsRAMECC_totalDual++;
+    }
+    RAMECC->INTFLAG.reg = flags.reg;
+}
+
+void fourRegsRAMECCTake(FourRegsRAMECCCounts &counts) {
+    __disable_irq();
+    counts.single = FourRegsRAMECC_single;
+    counts.dual = FourRegsRAMECC_dual;
+    counts.ms = millis() - FourRegsRAMECC_start;
+    FourRegsRAMECC_single = 0;
+    FourRegsRAMECC_dual = 0;
+    FourRegsRAMECC_start += counts.ms;
+    __enable_irq();
+}
+
+void printFourRegRAMECC(FourRegOptions &opts) {
+    opts.print.println("--------------------------- RAMECC");
+
+    PRINTRAW(RAMECC->INTENSET.reg);
+    opts.print.print("INTENSET: ");
+    PRINTFLAG(RAMECC->INTENSET, SINGLEE);
+    PRINTFLAG(RAMECC->INTENSET, DUALE);
+    PRINTNL();
+
+    PRINTRAW(RAMECC->INTFLAG.reg);
+    opts.print.print("INTFLAG: ");
+    PRINTFLAG(RAMECC->INTFLAG, SINGLEE);
+    PRINTFLAG(RAMECC->INTFLAG, DUALE);
+    if (RAMECC->INTFLAG.reg) {
+        opts.print.print(" ERRADDR=");
+        PRINTHEX(RAMECC->ERRADDR.bit.ERRADDR);
+    }
+    PRINTNL();
+
+    PRINTRAW(RAMECC->STATUS.reg);
+    opts.print.print("STATUS: ");
+    PRINTFLAG(RAMECC->STATUS, ECCDIS);
+    PRINTNL();
+
+    PRINTRAW(RAMECC->DBGCTRL.reg);
+    opts.print.print("DBGCTRL: ");
+    PRINTFLAG(RAMECC->DBGCTRL, ECCDIS);
+    PRINTFLAG(RAMECC->DBGCTRL, ECCELOG);
+    PRINTNL();
+
+    opts.print.print("MONITOR:  single=");
+    opts.print.print(FourRegsRAMECC_totalSingle);
+    opts.print.print(" dual=");
+    opts.print.print(FourRegsRAMECC_totalDual);
+    if (FourRegsRAMECC_totalSingle || FourRegsRAMECC_totalDual) {
+        opts.print.print(" ERRADDR=");
+        PRINTHEX(FourRegsRAMECC_lastAddr);
+    }
+    PRINTNL();
+}
+
+
+// The reset history is kept in backup RAM, which survives every reset except
+// power-on.  FOUR_REGS_HISTORY_ADDR can move it if the sketch uses the start
+// of backup RAM for something else.
+#ifndef FOUR_REGS_HISTORY_ADDR
+#define FOUR_REGS_HISTORY_ADDR BKUPRAM_ADDR
+#endif
+#define FourRegsHISTORY_MAGIC 0x48524634    // "4FRH"
+#define FourRegsHISTORY_VERSION 1
+#define FourRegsHISTORY_SIZE 8
+
+struct FourRegsHistory_Run {
+    uint8_t  rcause;        // RSTC.RCAUSE that started the run
+    uint8_t  bkupexit;      // RSTC.BKUPEXIT that started the run
+    uint16_t reserved;
+    uint32_t uptime;        // millis() at the last fourRegsResetHistoryUpdate()
+    uint32_t fingerprint;   // fourRegsFingerprint() at the last fourRegsResetHistoryUpdate()
+};
+struct FourRegsHistory {
+    uint32_t magic;
+    uint8_t  version;
+    uint8_t  count;         // number of runs recorded, up to FourRegsHISTORY_SIZE
+    uint8_t  next;          // where the next run will be recorded
+    uint8_t  reserved;
+    FourRegsHistory_Run runs[FourRegsHISTORY_SIZE];
+};
+#define FourRegsHISTORY ((volatile FourRegsHistory*) (FOUR_REGS_HISTORY_ADDR))
+
+void fourRegsResetHistoryRecord() {
+    volatile FourRegsHistory* history = FourRegsHISTORY;
+    // Backup RAM doesn't keep its contents through a power-on or brown-out
+    // reset, even if the old history happens to still look valid.
+    bool powered = RSTC->RCAUSE.reg & (RSTC_RCAUSE_POR | RSTC_RCAUSE_BODCORE | RSTC_RCAUSE_BODVDD);
+    if (powered || history->magic != FourRegsHISTORY_MAGIC || history->version != FourRegsHISTORY_VERSION
+            || history->count > FourRegsHISTORY_SIZE || history->next >= FourRegsHISTORY_SIZE) {
+        // first boot, or backup RAM lost power
+        memset((void*) history, 0, sizeof(FourRegsHistory));
+        history->magic = FourRegsHISTORY_MAGIC;
+        history->version = FourRegsHISTORY_VERSION;
+    }
+    volatile FourRegsHistory_Run* run = &history->runs[history->next];
+    run->rcause = RSTC->RCAUSE.reg;
+    run->bkupexit = RSTC->BKUPEXIT.reg;
+    run->uptime = millis();
+    run->fingerprint = fourRegsFingerprint();
+    history->next = (history->next + 1) % FourRegsHISTORY_SIZE;
+    if (history->count < FourRegsHISTORY_SIZE) {
+        history->count++;
+    }
+}
+
+void fourRegsResetHistoryUpdate() {
+    volatile FourRegsHistory* history = FourRegsHISTORY;
+    if (history->magic != FourRegsHISTORY_MAGIC || !history->count) {
+        return;
+    }
+    volatile FourRegsHistory_Run* run = &history->runs[(history->next + FourRegsHISTORY_SIZE - 1) % FourRegsHISTORY_SIZE];
+    run->uptime = millis();
+    run->fingerprint = fourRegsFingerprint();
+}
+
+void printFourRegRSTC_RCAUSE(FourRegOptions &opts, uint8_t rcause) {
+    RSTC_RCAUSE_Type cause;
+    cause.reg = rcause;
+    PRINTFLAG(cause, POR);
+    PRINTFLAG(cause, BODCORE);
+    PRINTFLAG(cause, BODVDD);
+    PRINTFLAG(cause, NVM);
+    PRINTFLAG(cause, EXT);
+    PRINTFLAG(cause, WDT);
+    PRINTFLAG(cause, SYST);
+    PRINTFLAG(cause, BACKUP);
+}
+
+void printFourRegRSTC_BKUPEXIT(FourRegOptions &opts, uint8_t bkupexit) {
+    RSTC_BKUPEXIT_Type bkup;
+    bkup.reg = bkupexit;
+    PRINTFLAG(bkup, RTC);
+    PRINTFLAG(bkup, BBPS);
+    PRINTFLAG(bkup, HIB);
+}
+
+void printFourRegRSTC(FourRegOptions &opts) {
+    opts.print.println("--------------------------- RSTC");
+
+    PRINTRAW(RSTC->RCAUSE.reg);
+    opts.print.print("RCAUSE: ");
+    printFourRegRSTC_RCAUSE(opts, RSTC->RCAUSE.reg);
+    PRINTNL();
+
+    PRINTRAW(RSTC->BKUPEXIT.reg);
+    opts.print.print("BKUPEXIT: ");
+    printFourRegRSTC_BKUPEXIT(opts, RSTC->BKUPEXIT.reg);
+    PRINTNL();
+
+    // oldest run first, each one ended by the reset which started the next
+    volatile FourRegsHistory* history = FourRegsHISTORY;
+    if (history->magic != FourRegsHISTORY_MAGIC || history->version != FourRegsHISTORY_VERSION
+            || history->count > FourRegsHISTORY_SIZE || history->next >= FourRegsHISTORY_SIZE) {
+        return;
+    }
+    uint8_t first = (history->next + FourRegsHISTORY_SIZE - history->count) % FourRegsHISTORY_SIZE;
+    for (uint8_t n = 0; n < history->count; n++) {
+        volatile FourRegsHistory_Run* run = &history->runs[(first + n) % FourRegsHISTORY_SIZE];
+        opts.print.print("RUN");
+        PRINTPAD2(n);
+        opts.print.print(": ");
+        printFourRegRSTC_RCAUSE(opts, run->rcause);
+        printFourRegRSTC_BKUPEXIT(opts, run->bkupexit);
+        opts.print.print(" uptime=");
+        opts.print.print(run->uptime);
+        opts.print.print("ms fingerprint=");
+        PRINTHEX(run->fingerprint);
+        PRINTNL();
+    }
+}
+
+
 void printFourRegRTC_BKUP(FourRegOptions &opts, volatile RTC_BKUP_Type *bkup) {
     for (uint8_t id = 0; id < 8; id++) {
         opts.print.print("BKUP");
@@ -2532,9 +4276,9 @@ void printFourRegRTC_TAMPCTRLn(FourRegOptions &opts, uint8_t idx, uint8_t inact,
     if (inact == 0x0 && !opts.showDisabled) {
         return;
     }
-    opts.print.print(" ");
+    opts.print.print(" in");
     opts.print.print(idx);
-    opts.print.print(":");
+    opts.print.print("=");
     switch (inact) {
         case 0x0: opts.print.print("OFF"); break;
         case 0x1: opts.print.print("WAKE"); break;
@@ -2562,6 +4306,7 @@ void printFourRegRTC_MODE0(FourRegOptions &opts) {
     opts.print.println("--------------------------- RTC COUNT32");
 
     while (RTC->MODE0.SYNCBUSY.bit.ENABLE) {}
+    PRINTRAW(RTC->MODE0.CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(RTC->MODE0.CTRLA, ENABLE);
     opts.print.print(" MODE=");
@@ -2574,6 +4319,7 @@ void printFourRegRTC_MODE0(FourRegOptions &opts) {
     PRINTFLAG(RTC->MODE0.CTRLA, COUNTSYNC);
     PRINTNL();
 
+    PRINTRAW(RTC->MODE0.CTRLB.reg);
     opts.print.print("CTRLB: ");
     PRINTFLAG(RTC->MODE0.CTRLB, GP0EN);
     PRINTFLAG(RTC->MODE0.CTRLB, GP2EN);
@@ -2587,6 +4333,7 @@ void printFourRegRTC_MODE0(FourRegOptions &opts) {
     PRINTHEX(RTC->MODE0.CTRLB.bit.ACTF);
     PRINTNL();
 
+    PRINTRAW(RTC->MODE0.EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     for (id = 0; id < 8; id++) {
         if (RTC->MODE0.EVCTRL.vec.PEREO & (1<<id)) {
@@ -2617,6 +4364,7 @@ void printFourRegRTC_MODE0(FourRegOptions &opts) {
     printFourRegRTC_GP(opts, RTC->MODE0.GP);
     printFourRegRTC_TAMPCTRL(opts, RTC->MODE0.TAMPCTRL);
 
+    PRINTRAW(RTC->MODE0.TIMESTAMP.reg);
     opts.print.print("TIMESTAMP:  ");
     opts.print.print(RTC->MODE0.TIMESTAMP.bit.COUNT);
     PRINTNL();
@@ -2629,6 +4377,7 @@ void printFourRegRTC_MODE1(FourRegOptions &opts) {
     opts.print.println("--------------------------- RTC COUNT16");
 
     while (RTC->MODE1.SYNCBUSY.bit.ENABLE) {}
+    PRINTRAW(RTC->MODE1.CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(RTC->MODE1.CTRLA, ENABLE);
     opts.print.print(" MODE=");
@@ -2640,6 +4389,7 @@ void printFourRegRTC_MODE1(FourRegOptions &opts) {
     PRINTFLAG(RTC->MODE1.CTRLA, COUNTSYNC);
     PRINTNL();
 
+    PRINTRAW(RTC->MODE1.CTRLB.reg);
     opts.print.print("CTRLB: ");
     PRINTFLAG(RTC->MODE1.CTRLB, GP0EN);
     PRINTFLAG(RTC->MODE1.CTRLB, GP2EN);
@@ -2653,6 +4403,7 @@ void printFourRegRTC_MODE1(FourRegOptions &opts) {
     PRINTHEX(RTC->MODE1.CTRLB.bit.ACTF);
     PRINTNL();
 
+    PRINTRAW(RTC->MODE1.EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     for (id = 0; id < 8; id++) {
         if (RTC->MODE1.EVCTRL.vec.PEREO & (1<<id)) {
@@ -2672,6 +4423,7 @@ void printFourRegRTC_MODE1(FourRegOptions &opts) {
     while (RTC->MODE1.SYNCBUSY.bit.FREQCORR);
     printFourRegRTC_FREQCORR(opts, RTC->MODE1.FREQCORR);
 
+    PRINTRAW(RTC->MODE1.PER.reg);
     opts.print.print("PER:  ");
     opts.print.print(RTC->MODE1.PER.bit.PER);
     PRINTNL();
@@ -2689,6 +4441,7 @@ void printFourRegRTC_MODE1(FourRegOptions &opts) {
     printFourRegRTC_GP(opts, RTC->MODE1.GP);
     printFourRegRTC_TAMPCTRL(opts, RTC->MODE1.TAMPCTRL);
 
+    PRINTRAW(RTC->MODE1.TIMESTAMP.reg);
     opts.print.print("TIMESTAMP:  ");
     opts.print.print(RTC->MODE1.TIMESTAMP.bit.COUNT);
     PRINTNL();
@@ -2701,6 +4454,7 @@ void printFourRegRTC_MODE2(FourRegOptions &opts) {
     opts.print.println("--------------------------- RTC CLOCK/CALENDAR");
 
     while (RTC->MODE2.SYNCBUSY.bit.ENABLE) {}
+    PRINTRAW(RTC->MODE2.CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(RTC->MODE2.CTRLA, ENABLE);
     opts.print.print(" MODE=");
@@ -2713,6 +4467,7 @@ void printFourRegRTC_MODE2(FourRegOptions &opts) {
     PRINTFLAG(RTC->MODE2.CTRLA, CLOCKSYNC);
     PRINTNL();
 
+    PRINTRAW(RTC->MODE2.CTRLB.reg);
     opts.print.print("CTRLB: ");
     PRINTFLAG(RTC->MODE2.CTRLB, GP0EN);
     PRINTFLAG(RTC->MODE2.CTRLB, GP2EN);
@@ -2726,6 +4481,7 @@ void printFourRegRTC_MODE2(FourRegOptions &opts) {
     PRINTHEX(RTC->MODE2.CTRLB.bit.ACTF);
     PRINTNL();
 
+    PRINTRAW(RTC->MODE2.EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     for (id = 0; id < 8; id++) {
         if (RTC->MODE2.EVCTRL.vec.PEREO & (1<<id)) {
@@ -2784,385 +4540,872 @@ void printFourRegRTC(FourRegOptions &opts) {
 }
 
 
-void printFourRegSCS(FourRegOptions &opts) {
-    opts.print.println("--------------------------- SCS");
+// memory type of an MPU region, from TEX/C/B (ARMv7-M ARM table B3-13)
+enum {
+    FourRegsMPU_ORDERED,    // strongly ordered
+    FourRegsMPU_DEVICE,
+    FourRegsMPU_UNCACHED,   // normal but not cacheable
+    FourRegsMPU_CACHED,
+};
 
-    opts.print.print("CPUID:  REV=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_REVISION));
-    opts.print.print(" PARTNO=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_PARTNO));
-    opts.print.print(" ARCH=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_ARCHITECTURE));
-    opts.print.print(" VAR=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_VARIANT));
-    opts.print.print(" IMPL=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_IMPLEMENTER));
-    PRINTNL();
+uint8_t fourRegsMPU_type(uint8_t tex, uint8_t c, uint8_t b) {
+    if (tex & 0x4) {
+        // outer policy in TEX[1:0], inner in C/B
+        return (c || b) ? FourRegsMPU_CACHED : FourRegsMPU_UNCACHED;
+    }
+    switch ((tex << 2) | (c << 1) | b) {
+        case 0x0: return FourRegsMPU_ORDERED;
+        case 0x1: return FourRegsMPU_DEVICE;
+        case 0x2: return FourRegsMPU_CACHED;    // write-through
+        case 0x3: return FourRegsMPU_CACHED;    // write-back
+        case 0x4: return FourRegsMPU_UNCACHED;
+        case 0x7: return FourRegsMPU_CACHED;    // write-back, write-allocate
+        case 0x8: return FourRegsMPU_DEVICE;    // not shareable
+    }
+    return 0xFF;
+}
 
-    opts.print.print("SysTick: ");
-    if (READSCS(SysTick->CTRL, SysTick_CTRL_ENABLE)) {
+void printFourRegSCS_MPU(FourRegOptions &opts) {
+    uint8_t count = READSCS(MPU->TYPE, MPU_TYPE_DREGION);
+    opts.print.print("MPU: ");
+    if (READSCS(MPU->CTRL, MPU_CTRL_ENABLE)) {
         opts.print.print(" ENABLE");
     }
-    if (READSCS(SysTick->CTRL, SysTick_CTRL_TICKINT)) {
-        opts.print.print(" TICKINT");
-    }
-    opts.print.print(" clksource=");
-    opts.print.print(READSCS(SysTick->CTRL, SysTick_CTRL_CLKSOURCE) ? "CPU" : "EXT");
-    opts.print.print(" RELOAD=");
-    opts.print.print(READSCS(SysTick->LOAD, SysTick_LOAD_RELOAD));
-    opts.print.print(" TENMS=");
-    opts.print.print(READSCS(SysTick->CALIB, SysTick_CALIB_TENMS));
-    if (READSCS(SysTick->CALIB, SysTick_CALIB_SKEW)) {
-        opts.print.print(" SKEW");
+    if (READSCS(MPU->CTRL, MPU_CTRL_HFNMIENA)) {
+        opts.print.print(" HFNMIENA");
     }
-    if (READSCS(SysTick->CALIB, SysTick_CALIB_NOREF)) {
-        opts.print.print(" NOREF");
+    if (READSCS(MPU->CTRL, MPU_CTRL_PRIVDEFENA)) {
+        opts.print.print(" PRIVDEFENA");
     }
+    opts.print.print(" DREGION=");
+    opts.print.print(count);
     PRINTNL();
+    if (count > 8) {
+        count = 8;
+    }
 
-    for (uint8_t pri = 0; pri < 8; pri++) {
-        opts.print.print("irq pri");
-        opts.print.print(pri);
+    // RNR selects which region RBAR/RASR show, so it's put back afterwards
+    // in case the sketch was in the middle of setting up a region.
+    uint32_t rbar[8];
+    uint32_t rasr[8];
+    __disable_irq();
+    uint32_t rnr = MPU->RNR;
+    for (uint8_t id = 0; id < count; id++) {
+        MPU->RNR = id;
+        rbar[id] = MPU->RBAR;
+        rasr[id] = MPU->RASR;
+    }
+    MPU->RNR = rnr;
+    __enable_irq();
+
+    for (uint8_t id = 0; id < count; id++) {
+        bool enabled = READSCS(rasr[id], MPU_RASR_ENABLE);
+        if (!enabled && !opts.showDisabled) {
+            continue;
+        }
+        opts.print.print("MPU");
+        opts.print.print(id);
         opts.print.print(": ");
-        for (uint8_t irq = 0; irq < PERIPH_COUNT_IRQn; irq++) {
-            if (pri == NVIC_GetPriority((IRQn_Type) irq)) {
-                switch (irq) {
-                    // [10.2.2 DSrevF] Interrupt Line Mapping
-                    case   0: opts.print.print(" PM"); break;
-                    case   1: opts.print.print(" MCLK"); break;
-                    case   2: opts.print.print(" OSCCTRL:0"); break;
-                    case   3: opts.print.print(" OSCCTRL:1"); break;
-                    case   4: opts.print.print(" OSCCTRL:2"); break;
-                    case   5: opts.print.print(" OSCCTRL:3"); break;
-                    case   6: opts.print.print(" OSCCTRL:4"); break;
-                    case   7: opts.print.print(" OSC32KCTRL"); break;
-                    case   8: opts.print.print(" SUPC:0"); break;
-                    case   9: opts.print.print(" SUPC:1"); break;
-                    case  10: opts.print.print(" WDT"); break;
-                    case  11: opts.print.print(" RTC"); break;
-                    case  12: opts.print.print(" EIC:0"); break;
-                    case  13: opts.print.print(" EIC:1"); break;
-                    case  14: opts.print.print(" EIC:2"); break;
-                    case  15: opts.print.print(" EIC:3"); break;
-                    case  16: opts.print.print(" EIC:4"); break;
-                    case  17: opts.print.print(" EIC:5"); break;
-                    case  18: opts.print.print(" EIC:6"); break;
-                    case  19: opts.print.print(" EIC:7"); break;
-                    case  20: opts.print.print(" EIC:8"); break;
-                    case  21: opts.print.print(" EIC:9"); break;
-                    case  22: opts.print.print(" EIC:10"); break;
-                    case  23: opts.print.print(" EIC:11"); break;
-                    case  24: opts.print.print(" EIC:12"); break;
-                    case  25: opts.print.print(" EIC:13"); break;
-                    case  26: opts.print.print(" EIC:14"); break;
-                    case  27: opts.print.print(" EIC:15"); break;
-                    case  28: opts.print.print(" FREQM"); break;
-                    case  29: opts.print.print(" NVMCTRL:0"); break;
-                    case  30: opts.print.print(" NVMCTRL:1"); break;
-                    case  31: opts.print.print(" DMAC:0"); break;
-                    case  32: opts.print.print(" DMAC:1"); break;
-                    case  33: opts.print.print(" DMAC:2"); break;
-                    case  34: opts.print.print(" DMAC:3"); break;
-                    case  35: opts.print.print(" DMAC:4"); break;
-                    case  36: opts.print.print(" EVSYS:0"); break;
-                    case  37: opts.print.print(" EVSYS:1"); break;
-                    case  38: opts.print.print(" EVSYS:2"); break;
-                    case  39: opts.print.print(" EVSYS:3"); break;
-                    case  40: opts.print.print(" EVSYS:4"); break;
-                    case  41: opts.print.print(" PAC"); break;
-                    /*    42*/
-                    /*    43*/
-                    /*    44*/
-                    case  45: opts.print.print(" RAMECC"); break;
-                    case  46: opts.print.print(" SERCOM0:0"); break;
-                    case  47: opts.print.print(" SERCOM0:1"); break;
-                    case  48: opts.print.print(" SERCOM0:2"); break;
-                    case  49: opts.print.print(" SERCOM0:3"); break;
-                    case  50: opts.print.print(" SERCOM1:0"); break;
-                    case  51: opts.print.print(" SERCOM1:1"); break;
-                    case  52: opts.print.print(" SERCOM1:2"); break;
-                    case  53: opts.print.print(" SERCOM1:3"); break;
-                    case  54: opts.print.print(" SERCOM2:0"); break;
-                    case  55: opts.print.print(" SERCOM2:1"); break;
-                    case  56: opts.print.print(" SERCOM2:2"); break;
-                    case  57: opts.print.print(" SERCOM2:3"); break;
-                    case  58: opts.print.print(" SERCOM3:0"); break;
-                    case  59: opts.print.print(" SERCOM3:1"); break;
-                    case  60: opts.print.print(" SERCOM3:2"); break;
-                    case  61: opts.print.print(" SERCOM3:3"); break;
-                    case  62: opts.print.print(" SERCOM4:0"); break;
-                    case  63: opts.print.print(" SERCOM4:1"); break;
-                    case  64: opts.print.print(" SERCOM4:2"); break;
-                    case  65: opts.print.print(" SERCOM4:3"); break;
-                    case  66: opts.print.print(" SERCOM5:0"); break;
-                    case  67: opts.print.print(" SERCOM5:1"); break;
-                    case  68: opts.print.print(" SERCOM5:2"); break;
-                    case  69: opts.print.print(" SERCOM5:3"); break;
+        if (!enabled) {
+            opts.print.print(" ");
+            opts.print.println(FourRegs__DISABLED);
+            continue;
+        }
+        uint32_t base = rbar[id] & MPU_RBAR_ADDR_Msk;
+        uint64_t end = base + (2ULL << READSCS(rasr[id], MPU_RASR_SIZE));
+        opts.print.print(" base=");
+        PRINTHEX(base);
+        opts.print.print(" size=");
+        opts.print.print((uint32_t) (end - base - 1));
+        opts.print.print("+1 SRD=");
+        PRINTHEX(READSCS(rasr[id], MPU_RASR_SRD));
+        opts.print.print(" ap=");
+        switch (READSCS(rasr[id], MPU_RASR_AP)) {
+            case 0x0: opts.print.print("NONE"); break;
+            case 0x1: opts.print.print("PRIV_RW"); break;
+            case 0x2: opts.print.print("PRIV_RW_USER_RO"); break;
+            case 0x3: opts.print.print("RW"); break;
+            case 0x5: opts.print.print("PRIV_RO"); break;
+            case 0x6:
+            case 0x7: opts.print.print("RO"); break;
+            default:  opts.print.print(FourRegs__RESERVED); break;
+        }
+        if (READSCS(rasr[id], MPU_RASR_XN)) {
+            opts.print.print(" XN");
+        }
+        opts.print.print(" TEX=");
+        PRINTHEX(READSCS(rasr[id], MPU_RASR_TEX));
+        if (READSCS(rasr[id], MPU_RASR_C)) {
+            opts.print.print(" C");
+        }
+        if (READSCS(rasr[id], MPU_RASR_B)) {
+            opts.print.print(" B");
+        }
+        if (READSCS(rasr[id], MPU_RASR_S)) {
+            opts.print.print(" S");
+        }
+        uint8_t type = fourRegsMPU_type(READSCS(rasr[id], MPU_RASR_TEX), READSCS(rasr[id], MPU_RASR_C), READSCS(rasr[id], MPU_RASR_B));
+        opts.print.print(" mem=");
+        switch (type) {
+            case FourRegsMPU_ORDERED:  opts.print.print("ORDERED"); break;
+            case FourRegsMPU_DEVICE:   opts.print.print("DEVICE"); break;
+            case FourRegsMPU_UNCACHED: opts.print.print("UNCACHED"); break;
+            case FourRegsMPU_CACHED:   opts.print.print("CACHED"); break;
+            default:                   opts.print.print(FourRegs__RESERVED); break;
+        }
+
+        // Code or data in SRAM or QSPI flash marked as device or strongly
+        // ordered memory loses write buffering, and uncached loses the cache.
+        if (type != FourRegsMPU_CACHED) {
+            if (base < HSRAM_ADDR + HSRAM_SIZE && end > HSRAM_ADDR) {
+                opts.print.print(" SLOW_SRAM");
+            }
+            if (base < QSPI_ADDR + QSPI_SIZE && end > QSPI_ADDR) {
+                opts.print.print(" SLOW_QSPI");
+            }
+        }
+
+        // the higher numbered region wins where regions overlap (subregions aren't considered)
+        for (uint8_t other = 0; other < count; other++) {
+            if (other == id || !READSCS(rasr[other], MPU_RASR_ENABLE)) {
+                continue;
+            }
+            uint32_t obase = rbar[other] & MPU_RBAR_ADDR_Msk;
+            uint64_t oend = obase + (2ULL << READSCS(rasr[other], MPU_RASR_SIZE));
+            if (base < oend && obase < end) {
+                opts.print.print(" overlap=MPU");
+                opts.print.print(other);
+            }
+        }
+        PRINTNL();
+    }
+}
+
+// [10.2.2 DSrevF] Interrupt Line Mapping
+// Runs of consecutive IRQs from the same peripheral, printed as NAME:n.
+struct FourRegsIRQ_Run {
+    uint8_t     first;
+    uint8_t     count;
+    const char* name;
+};
+const FourRegsIRQ_Run FourRegsIRQ_RUNs[] = {
+    {   0,  1, "PM" },
+    {   1,  1, "MCLK" },
+    {   2,  5, "OSCCTRL" },
+    {   7,  1, "OSC32KCTRL" },
+    {   8,  2, "SUPC" },
+    {  10,  1, "WDT" },
+    {  11,  1, "RTC" },
+    {  12, 16, "EIC" },
+    {  28,  1, "FREQM" },
+    {  29,  2, "NVMCTRL" },
+    {  31,  5, "DMAC" },
+    {  36,  5, "EVSYS" },
+    {  41,  1, "PAC" },
+    {  45,  1, "RAMECC" },
+    {  46,  4, "SERCOM0" },
+    {  50,  4, "SERCOM1" },
+    {  54,  4, "SERCOM2" },
+    {  58,  4, "SERCOM3" },
+    {  62,  4, "SERCOM4" },
+    {  66,  4, "SERCOM5" },
 #ifdef SERCOM6
-                    case  70: opts.print.print(" SERCOM6:0"); break;
-                    case  71: opts.print.print(" SERCOM6:1"); break;
-                    case  72: opts.print.print(" SERCOM6:2"); break;
-                    case  73: opts.print.print(" SERCOM6:3"); break;
+    {  70,  4, "SERCOM6" },
 #endif
 #ifdef SERCOM7
-                    case  74: opts.print.print(" SERCOM7:0"); break;
-                    case  75: opts.print.print(" SERCOM7:1"); break;
-                    case  76: opts.print.print(" SERCOM7:2"); break;
-                    case  77: opts.print.print(" SERCOM7:3"); break;
+    {  74,  4, "SERCOM7" },
 #endif
 #ifdef CAN0
-                    case  78: opts.print.print(" CAN0"); break;
+    {  78,  1, "CAN0" },
 #endif
 #ifdef CAN1
-                    case  79: opts.print.print(" CAN1"); break;
+    {  79,  1, "CAN1" },
 #endif
-                    case  80: opts.print.print(" USB:0"); break;
-                    case  81: opts.print.print(" USB:1"); break;
-                    case  82: opts.print.print(" USB:2"); break;
-                    case  83: opts.print.print(" USB:3"); break;
+    {  80,  4, "USB" },
 #ifdef GMAC
-                    case  84: opts.print.print(" GMAC"); break;
+    {  84,  1, "GMAC" },
 #endif
-                    case  85: opts.print.print(" TCC0:0"); break;
-                    case  86: opts.print.print(" TCC0:1"); break;
-                    case  87: opts.print.print(" TCC0:2"); break;
-                    case  88: opts.print.print(" TCC0:3"); break;
-                    case  89: opts.print.print(" TCC0:4"); break;
-                    case  90: opts.print.print(" TCC0:5"); break;
-                    case  91: opts.print.print(" TCC0:6"); break;
-                    case  92: opts.print.print(" TCC1:0"); break;
-                    case  93: opts.print.print(" TCC1:1"); break;
-                    case  94: opts.print.print(" TCC1:2"); break;
-                    case  95: opts.print.print(" TCC1:3"); break;
-                    case  96: opts.print.print(" TCC1:4"); break;
-                    case  97: opts.print.print(" TCC2:0"); break;
-                    case  98: opts.print.print(" TCC2:1"); break;
-                    case  99: opts.print.print(" TCC2:2"); break;
-                    case 100: opts.print.print(" TCC2:3"); break;
+    {  85,  7, "TCC0" },
+    {  92,  5, "TCC1" },
+    {  97,  4, "TCC2" },
 #ifdef TCC3
-                    case 101: opts.print.print(" TCC3:0"); break;
-                    case 102: opts.print.print(" TCC3:1"); break;
-                    case 103: opts.print.print(" TCC3:2"); break;
+    { 101,  3, "TCC3" },
 #endif
 #ifdef TCC4
-                    case 104: opts.print.print(" TCC4:0"); break;
-                    case 105: opts.print.print(" TCC4:1"); break;
-                    case 106: opts.print.print(" TCC4:2"); break;
+    { 104,  3, "TCC4" },
 #endif
-                    case 107: opts.print.print(" TC0"); break;
-                    case 108: opts.print.print(" TC1"); break;
-                    case 109: opts.print.print(" TC2"); break;
-                    case 110: opts.print.print(" TC3"); break;
+    { 107,  1, "TC0" },
+    { 108,  1, "TC1" },
+    { 109,  1, "TC2" },
+    { 110,  1, "TC3" },
 #ifdef TC4
-                    case 111: opts.print.print(" TC4"); break;
+    { 111,  1, "TC4" },
 #endif
 #ifdef TC5
-                    case 112: opts.print.print(" TC5"); break;
+    { 112,  1, "TC5" },
 #endif
 #ifdef TC6
-                    case 113: opts.print.print(" TC6"); break;
+    { 113,  1, "TC6" },
 #endif
 #ifdef TC7
-                    case 114: opts.print.print(" TC7"); break;
+    { 114,  1, "TC7" },
 #endif
-                    case 115: opts.print.print(" PDEC:0"); break;
-                    case 116: opts.print.print(" PDEC:1"); break;
-                    case 117: opts.print.print(" PDEC:2"); break;
-                    case 118: opts.print.print(" ADC0:0"); break;
-                    case 119: opts.print.print(" ADC0:1"); break;
-                    case 120: opts.print.print(" ADC1:0"); break;
-                    case 121: opts.print.print(" ADC1:1"); break;
-                    case 122: opts.print.print(" AC"); break;
-                    case 123: opts.print.print(" DAC:0"); break;
-                    case 124: opts.print.print(" DAC:1"); break;
-                    case 125: opts.print.print(" DAC:2"); break;
-                    case 126: opts.print.print(" DAC:3"); break;
-                    case 127: opts.print.print(" DAC:4"); break;
+    { 115,  3, "PDEC" },
+    { 118,  2, "ADC0" },
+    { 120,  2, "ADC1" },
+    { 122,  1, "AC" },
+    { 123,  5, "DAC" },
 #ifdef I2S
-                    case 128: opts.print.print(" I2S"); break;
+    { 128,  1, "I2S" },
 #endif
-                    case 129: opts.print.print(" PCC"); break;
-                    case 130: opts.print.print(" AES"); break;
-                    case 131: opts.print.print(" TRNG"); break;
-                    case 132: opts.print.print(" ICM"); break;
-                    case 133: opts.print.print(" PUKCC"); break;
-                    case 134: opts.print.print(" QSPI"); break;
-                    case 135: opts.print.print(" SDHC0"); break;
+    { 129,  1, "PCC" },
+    { 130,  1, "AES" },
+    { 131,  1, "TRNG" },
+    { 132,  1, "ICM" },
+    { 133,  1, "PUKCC" },
+    { 134,  1, "QSPI" },
+    { 135,  1, "SDHC0" },
 #ifdef SDHC1
-                    case 136: opts.print.print(" SDHC1"); break;
+    { 136,  1, "SDHC1" },
 #endif
-                }
-            }
+    { 0xFF, 0, NULL }
+};
+
+// prints " NAME" or " NAME:n", returns false if the IRQ isn't on this chip
+bool printFourRegIRQ_NAME(FourRegOptions &opts, uint8_t irq) {
+    for (const FourRegsIRQ_Run* run = FourRegsIRQ_RUNs; run->name; run++) {
+        if (irq < run->first || irq >= run->first + run->count) {
+            continue;
         }
-        PRINTNL();
+        opts.print.print(" ");
+        opts.print.print(run->name);
+        if (run->count > 1) {
+            opts.print.print(":");
+            opts.print.print(irq - run->first);
+        }
+        return true;
     }
+    return false;
 }
 
+void printFourRegSCS(FourRegOptions &opts) {
+    opts.print.println("--------------------------- SCS");
+
+    PRINTRAW(SCB->CPUID);
+    opts.print.print("CPUID:  REV=");
+    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_REVISION));
+    opts.print.print(" PARTNO=");
+    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_PARTNO));
+    opts.print.print(" ARCH=");
+    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_ARCHITECTURE));
+    opts.print.print(" VAR=");
+    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_VARIANT));
+    opts.print.print(" IMPL=");
+    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_IMPLEMENTER));
+    PRINTNL();
 
-// `pmux` is a string "SERCOMx:y"
-void printFourRegSERCOM_pinhint(FourRegOptions &opts, const char* pmux) {
-    if (!pmux) {
-        return;
+    opts.print.print("SysTick: ");
+    if (READSCS(SysTick->CTRL, SysTick_CTRL_ENABLE)) {
+        opts.print.print(" ENABLE");
     }
-    uint8_t x = pmux[6] - '0';
-    uint8_t y = pmux[8] - '0';
-    Sercom* sercom;
-    switch (x) {
-        case 0: sercom = SERCOM0; break;
-        case 1: sercom = SERCOM1; break;
-        case 2: sercom = SERCOM2; break;
-        case 3: sercom = SERCOM3; break;
-        case 4: sercom = SERCOM4; break;
-        case 5: sercom = SERCOM5; break;
-#ifdef SERCOM6
-        case 6: sercom = SERCOM6; break;
-#endif
-#ifdef SERCOM7
-        case 7: sercom = SERCOM7; break;
+    if (READSCS(SysTick->CTRL, SysTick_CTRL_TICKINT)) {
+        opts.print.print(" TICKINT");
+    }
+    opts.print.print(" clksource=");
+    opts.print.print(READSCS(SysTick->CTRL, SysTick_CTRL_CLKSOURCE) ? "CPU" : "EXT");
+    opts.print.print(" RELOAD=");
+    opts.print.print(READSCS(SysTick->LOAD, SysTick_LOAD_RELOAD));
+    opts.print.print(" TENMS=");
+    opts.print.print(READSCS(SysTick->CALIB, SysTick_CALIB_TENMS));
+    if (READSCS(SysTick->CALIB, SysTick_CALIB_SKEW)) {
+        opts.print.print(" SKEW");
+    }
+    if (READSCS(SysTick->CALIB, SysTick_CALIB_NOREF)) {
+        opts.print.print(" NOREF");
+    }
+    PRINTNL();
+
+    // CP10 and CP11 are the FPU, and need the same access
+    PRINTRAW(SCB->CPACR);
+    opts.print.print("CPACR:  fpu=");
+    switch ((SCB->CPACR >> 20) & 0x3) {
+        case 0x0: opts.print.print("DENIED"); break;
+        case 0x1: opts.print.print("PRIV"); break;
+        case 0x3: opts.print.print("FULL"); break;
+        default:  opts.print.print(FourRegs__RESERVED); break;
+    }
+    PRINTNL();
+
+#if (__FPU_PRESENT == 1)
+    PRINTRAW(FPU->FPCCR);
+    opts.print.print("FPCCR: ");
+    if (READSCS(FPU->FPCCR, FPU_FPCCR_ASPEN)) {
+        opts.print.print(" ASPEN");
+    }
+    if (READSCS(FPU->FPCCR, FPU_FPCCR_LSPEN)) {
+        opts.print.print(" LSPEN");
+    }
+    if (READSCS(FPU->FPCCR, FPU_FPCCR_LSPACT)) {
+        opts.print.print(" LSPACT");
+    }
+    PRINTNL();
 #endif
-        default: return;
+
+    PRINTRAW(SCB->CCR);
+    opts.print.print("CCR: ");
+    if (READSCS(SCB->CCR, SCB_CCR_NONBASETHRDENA)) {
+        opts.print.print(" NONBASETHRDENA");
     }
-    const char* pads[4];
-    pads[0] = NULL;
-    pads[1] = NULL;
-    pads[2] = NULL;
-    pads[3] = NULL;
-    switch (sercom->I2CM.CTRLA.bit.MODE) {
-        case 0x0:
-            // USART external clock
-            switch (sercom->USART.CTRLA.bit.RXPO) {
-                case 0x0: pads[0] = FourRegs__usart_rx; break;
-                case 0x1: pads[1] = FourRegs__usart_rx; break;
-                case 0x2: pads[2] = FourRegs__usart_rx; break;
-                case 0x3: pads[3] = FourRegs__usart_rx; break;
+    if (READSCS(SCB->CCR, SCB_CCR_USERSETMPEND)) {
+        opts.print.print(" USERSETMPEND");
+    }
+    if (READSCS(SCB->CCR, SCB_CCR_UNALIGN_TRP)) {
+        opts.print.print(" UNALIGN_TRP");
+    }
+    if (READSCS(SCB->CCR, SCB_CCR_DIV_0_TRP)) {
+        opts.print.print(" DIV_0_TRP");
+    }
+    if (READSCS(SCB->CCR, SCB_CCR_BFHFNMIGN)) {
+        opts.print.print(" BFHFNMIGN");
+    }
+    if (READSCS(SCB->CCR, SCB_CCR_STKALIGN)) {
+        opts.print.print(" STKALIGN");
+    }
+    PRINTNL();
+
+    // any of these slow the core down, they're meant for debugging
+    PRINTRAW(SCnSCB->ACTLR);
+    opts.print.print("ACTLR: ");
+    if (READSCS(SCnSCB->ACTLR, SCnSCB_ACTLR_DISMCYCINT)) {
+        opts.print.print(" DISMCYCINT");
+    }
+    if (READSCS(SCnSCB->ACTLR, SCnSCB_ACTLR_DISDEFWBUF)) {
+        opts.print.print(" DISDEFWBUF");
+    }
+    if (READSCS(SCnSCB->ACTLR, SCnSCB_ACTLR_DISFOLD)) {
+        opts.print.print(" DISFOLD");
+    }
+    if (READSCS(SCnSCB->ACTLR, SCnSCB_ACTLR_DISFPCA)) {
+        opts.print.print(" DISFPCA");
+    }
+    if (READSCS(SCnSCB->ACTLR, SCnSCB_ACTLR_DISOOFP)) {
+        opts.print.print(" DISOOFP");
+    }
+    PRINTNL();
+
+    PRINTRAW(SCB->VTOR);
+    opts.print.print("VTOR:  ");
+    PRINTHEX(SCB->VTOR);
+    opts.print.print(" in=");
+    if (SCB->VTOR < FLASH_ADDR + FLASH_SIZE) {
+        opts.print.print("FLASH");
+    } else if (SCB->VTOR >= HSRAM_ADDR && SCB->VTOR < HSRAM_ADDR + HSRAM_SIZE) {
+        opts.print.print("SRAM");
+    } else {
+        opts.print.print(FourRegs__UNKNOWN);
+    }
+    PRINTNL();
+
+    printFourRegSCS_MPU(opts);
+
+    uint8_t prigroup = READSCS(SCB->AIRCR, SCB_AIRCR_PRIGROUP);
+    uint8_t preempt = 7 - prigroup;
+    if (preempt > __NVIC_PRIO_BITS) {
+        preempt = __NVIC_PRIO_BITS;
+    }
+    opts.print.print("AIRCR:  PRIGROUP=");
+    opts.print.print(prigroup);
+    opts.print.print(" preempt=");
+    opts.print.print(preempt);
+    opts.print.print("bit sub=");
+    opts.print.print(__NVIC_PRIO_BITS - preempt);
+    opts.print.print("bit");
+    PRINTNL();
+
+    // Each NVIC register is read once, then the IRQs are bucketed by priority.
+    const uint8_t words = (PERIPH_COUNT_IRQn + 31) / 32;
+    uint32_t iser[words];
+    uint32_t ispr[words];
+    uint32_t iabr[words];
+    for (uint8_t w = 0; w < words; w++) {
+        iser[w] = NVIC->ISER[w];
+        ispr[w] = NVIC->ISPR[w];
+        iabr[w] = NVIC->IABR[w];
+    }
+    uint8_t pris[PERIPH_COUNT_IRQn];
+    uint8_t used = 0;
+    for (uint8_t irq = 0; irq < PERIPH_COUNT_IRQn; irq++) {
+        uint32_t bit = 1UL << (irq & 31);
+        pris[irq] = NVIC->IP[irq] >> (8 - __NVIC_PRIO_BITS);
+        if (opts.showDisabled || ((iser[irq >> 5] | ispr[irq >> 5] | iabr[irq >> 5]) & bit)) {
+            used |= 1 << pris[irq];
+        }
+    }
+    for (uint8_t pri = 0; pri < (1 << __NVIC_PRIO_BITS); pri++) {
+        if (!(used & (1 << pri))) {
+            continue;
+        }
+        opts.print.print("irq pri");
+        opts.print.print(pri);
+        opts.print.print(": ");
+        for (uint8_t irq = 0; irq < PERIPH_COUNT_IRQn; irq++) {
+            if (pris[irq] != pri) {
+                continue;
             }
-            switch (sercom->USART.CTRLA.bit.TXPO) {
-                case 0x0:
-                    pads[0] = FourRegs__usart_tx;
-                    pads[1] = FourRegs__usart_xck;
-                    break;
-                case 0x1:
-                    pads[2] = FourRegs__usart_tx;
-                    pads[3] = FourRegs__usart_xck;
-                    break;
-                case 0x2:
-                    pads[0] = FourRegs__usart_tx;
-                    pads[2] = FourRegs__usart_rts;
-                    pads[2] = FourRegs__usart_cts;
-                    break;
+            uint32_t bit = 1UL << (irq & 31);
+            bool enabled = iser[irq >> 5] & bit;
+            bool pending = ispr[irq >> 5] & bit;
+            bool active = iabr[irq >> 5] & bit;
+            if (!enabled && !pending && !active && !opts.showDisabled) {
+                continue;
             }
-            break;
-        case 0x1:
-            // USART internal clock
-            switch (sercom->USART.CTRLA.bit.RXPO) {
-                case 0x0: pads[0] = FourRegs__usart_rx; break;
-                case 0x1: pads[1] = FourRegs__usart_rx; break;
-                case 0x2: pads[2] = FourRegs__usart_rx; break;
-                case 0x3: pads[3] = FourRegs__usart_rx; break;
+            if (!printFourRegIRQ_NAME(opts, irq)) {
+                continue;
+            }
+            if (!enabled) {
+                opts.print.print("+DIS");
+            }
+            if (pending) {
+                opts.print.print("+PEND");
+            }
+            if (active) {
+                opts.print.print("+ACT");
             }
+        }
+        PRINTNL();
+    }
+}
+
+
+// A copy of the vector table in SRAM, so that entries can be replaced at
+// runtime.  VTOR needs the table aligned to its size rounded up to a power of
+// two.
+#define FourRegsVECTOR_COUNT (16 + PERIPH_COUNT_IRQn)
+typedef void (*FourRegsVector)();
+static FourRegsVector FourRegsVECTORs[FourRegsVECTOR_COUNT] __attribute__((aligned(1024)));
+
+void fourRegsVectorsToSRAM() {
+    if (SCB->VTOR == (uint32_t) FourRegsVECTORs) {
+        return;
+    }
+    const FourRegsVector* current = (const FourRegsVector*) SCB->VTOR;
+    for (uint16_t v = 0; v < FourRegsVECTOR_COUNT; v++) {
+        FourRegsVECTORs[v] = current[v];
+    }
+    __disable_irq();
+    __DSB();
+    SCB->VTOR = (uint32_t) FourRegsVECTORs;
+    __DSB();
+    __enable_irq();
+}
+
+
+static FourRegsVector FourRegsIRQPROFILE_handlers[PERIPH_COUNT_IRQn];
+static volatile uint32_t FourRegsIRQPROFILE_counts[PERIPH_COUNT_IRQn];
+static volatile uint64_t FourRegsIRQPROFILE_cycles[PERIPH_COUNT_IRQn];
+static volatile uint32_t FourRegsIRQPROFILE_nested = 0;
+static uint32_t FourRegsIRQPROFILE_start = 0;
+static bool FourRegsIRQPROFILE_running = false;
+
+// All profiled vectors point here.  Cycles spent in handlers which preempt
+// this one are subtracted, so each IRQ is only charged for its own time.
+void fourRegsIRQProfileHandler() {
+    uint8_t irq = (__get_IPSR() & 0x1FF) - 16;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t outer = FourRegsIRQPROFILE_nested;
+    FourRegsIRQPROFILE_nested = 0;
+    uint32_t start = DWT->CYCCNT;
+    __set_PRIMASK(primask);
+
+    FourRegsIRQPROFILE_handlers[irq]();
+
+    __disable_irq();
+    uint32_t cycles = DWT->CYCCNT - start;
+    FourRegsIRQPROFILE_counts[irq]++;
+    FourRegsIRQPROFILE_cycles[irq] += cycles - FourRegsIRQPROFILE_nested;
+    FourRegsIRQPROFILE_nested = outer + cycles;
+    __set_PRIMASK(primask);
+}
+
+void fourRegsIRQProfileStart() {
+    if (FourRegsIRQPROFILE_running) {
+        return;
+    }
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    fourRegsVectorsToSRAM();
+    __disable_irq();
+    for (uint8_t irq = 0; irq < PERIPH_COUNT_IRQn; irq++) {
+        FourRegsIRQPROFILE_handlers[irq] = FourRegsVECTORs[16 + irq];
+        FourRegsIRQPROFILE_counts[irq] = 0;
+        FourRegsIRQPROFILE_cycles[irq] = 0;
+        FourRegsVECTORs[16 + irq] = fourRegsIRQProfileHandler;
+    }
+    FourRegsIRQPROFILE_nested = 0;
+    FourRegsIRQPROFILE_start = millis();
+    FourRegsIRQPROFILE_running = true;
+    __DSB();
+    __enable_irq();
+}
+
+void fourRegsIRQProfileStop() {
+    if (!FourRegsIRQPROFILE_running) {
+        return;
+    }
+    __disable_irq();
+    for (uint8_t irq = 0; irq < PERIPH_COUNT_IRQn; irq++) {
+        FourRegsVECTORs[16 + irq] = FourRegsIRQPROFILE_handlers[irq];
+    }
+    FourRegsIRQPROFILE_running = false;
+    __DSB();
+    __enable_irq();
+}
+
+void printFourRegIRQProfile(FourRegOptions &opts) {
+    opts.print.println("--------------------------- IRQ PROFILE");
+    if (!FourRegsIRQPROFILE_running) {
+        opts.print.println(FourRegs__DISABLED);
+        return;
+    }
+    uint32_t ms = millis() - FourRegsIRQPROFILE_start;
+    uint32_t cpuHz = fourRegsGeneratorHz(0) / (MCLK->CPUDIV.reg ? MCLK->CPUDIV.reg : 1);
+    opts.print.print("TIME:  ms=");
+    opts.print.print(ms);
+    opts.print.print(" cpu=");
+    printFourReg_HZ(opts, cpuHz);
+    PRINTNL();
+    if (!ms) {
+        return;
+    }
+    float total = (float) ms * cpuHz / 1000.0;
+    for (uint8_t irq = 0; irq < PERIPH_COUNT_IRQn; irq++) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        uint32_t count = FourRegsIRQPROFILE_counts[irq];
+        uint64_t cycles = FourRegsIRQPROFILE_cycles[irq];
+        __set_PRIMASK(primask);
+        if (!count && !opts.showDisabled) {
+            continue;
+        }
+        opts.print.print("irq");
+        opts.print.print(irq);
+        opts.print.print(": ");
+        if (!printFourRegIRQ_NAME(opts, irq)) {
+            opts.print.print(" ");
+            opts.print.print(FourRegs__UNKNOWN);
+        }
+        opts.print.print(" count=");
+        opts.print.print(count);
+        opts.print.print(" rate=");
+        opts.print.print(count * 1000.0 / ms, 1);
+        opts.print.print("/s cycles=");
+        opts.print.print(count ? (uint32_t) (cycles / count) : 0);
+        opts.print.print("/irq load=");
+        opts.print.print(total ? cycles * 100.0 / total : 0, 2);
+        opts.print.print("%");
+        PRINTNL();
+    }
+}
+
+
+#ifdef SDHC0
+void printFourRegSDHC(FourRegOptions &opts, Sdhc* sdhc, uint8_t idx) {
+    bool enabled = (idx == 0) ? MCLK->AHBMASK.bit.SDHC0_ : MCLK->AHBMASK.bit.SDHC1_;
+    if (!enabled || !sdhc->CCR.bit.INTCLKEN) {
+        if (opts.showDisabled) {
+            opts.print.print("--------------------------- SDHC");
+            opts.print.print(idx);
+            PRINTNL();
+            opts.print.println(FourRegs__DISABLED);
+        }
+        return;
+    }
+    opts.print.print("--------------------------- SDHC");
+    opts.print.print(idx);
+    PRINTNL();
+
+    uint8_t width = sdhc->HC1R.bit.DW ? 4 : 1;
+    PRINTRAW(sdhc->HC1R.reg);
+    opts.print.print("HC1R:  dw=");
+    opts.print.print(width);
+    opts.print.print("BIT");
+    PRINTFLAG(sdhc->HC1R, HSEN);
+    opts.print.print(" dmasel=");
+    switch (sdhc->HC1R.bit.DMASEL) {
+        case 0x0: opts.print.print("SDMA"); break;
+        case 0x2: opts.print.print("ADMA2"); break;
+        default:  opts.print.print(FourRegs__RESERVED); break;
+    }
+    PRINTFLAG(sdhc->HC1R, CARDDTL);
+    PRINTFLAG(sdhc->HC1R, CARDDSEL);
+    PRINTNL();
+
+    PRINTRAW(sdhc->HC2R.reg);
+    opts.print.print("HC2R:  UHSMS=");
+    PRINTHEX(sdhc->HC2R.bit.UHSMS);
+    PRINTFLAG(sdhc->HC2R, VS18EN);
+    opts.print.print(" DRVSEL=");
+    PRINTHEX(sdhc->HC2R.bit.DRVSEL);
+    PRINTFLAG(sdhc->HC2R, SLCKSEL);
+    PRINTFLAG(sdhc->HC2R, ASINTEN);
+    PRINTFLAG(sdhc->HC2R, PVALEN);
+    PRINTNL();
+
+    PRINTRAW(sdhc->PCR.reg);
+    opts.print.print("PCR: ");
+    PRINTFLAG(sdhc->PCR, SDBPWR);
+    opts.print.print(" SDBVSEL=");
+    PRINTHEX(sdhc->PCR.bit.SDBVSEL);
+    PRINTNL();
+
+    // SD clock, from the CCR divider
+    uint32_t base = fourRegsChannelHz(idx == 0 ? 45 : 46);
+    uint16_t div = (sdhc->CCR.bit.USDCLKFSEL << 8) | sdhc->CCR.bit.SDCLKFSEL;
+    uint32_t sdclk;
+    if (sdhc->CCR.bit.CLKGSEL) {
+        // programmable clock
+        sdclk = base * (sdhc->CA1R.bit.CLKMULT + 1) / (div + 1);
+    } else {
+        sdclk = div ? base / (2 * div) : base;
+    }
+    PRINTRAW(sdhc->CCR.reg);
+    opts.print.print("CCR: ");
+    PRINTFLAG(sdhc->CCR, INTCLKEN);
+    PRINTFLAG(sdhc->CCR, INTCLKS);
+    PRINTFLAG(sdhc->CCR, SDCLKEN);
+    opts.print.print(" clkgsel=");
+    opts.print.print(sdhc->CCR.bit.CLKGSEL ? "PROG" : "DIV");
+    opts.print.print(" div=");
+    opts.print.print(div);
+    opts.print.print(" sdclk=");
+    printFourReg_HZ(opts, sdclk);
+    PRINTNL();
+
+    PRINTRAW(sdhc->TCR.reg);
+    opts.print.print("TCR:  DTCVAL=");
+    PRINTHEX(sdhc->TCR.bit.DTCVAL);
+    PRINTNL();
+
+    PRINTRAW(sdhc->TMR.reg);
+    opts.print.print("TMR: ");
+    PRINTFLAG(sdhc->TMR, DMAEN);
+    PRINTFLAG(sdhc->TMR, BCEN);
+    opts.print.print(" acmden=");
+    switch (sdhc->TMR.bit.ACMDEN) {
+        case 0x0: opts.print.print("none"); break;
+        case 0x1: opts.print.print("CMD12"); break;
+        case 0x2: opts.print.print("CMD23"); break;
+        default:  opts.print.print(FourRegs__RESERVED); break;
+    }
+    opts.print.print(" dtdsel=");
+    opts.print.print(sdhc->TMR.bit.DTDSEL ? "READ" : "WRITE");
+    PRINTFLAG(sdhc->TMR, MSBSEL);
+    PRINTNL();
+
+    PRINTRAW(sdhc->BSR.reg);
+    opts.print.print("BSR:  BLKSIZE=");
+    opts.print.print(sdhc->BSR.bit.BLKSIZE);
+    opts.print.print(" boundary=");
+    opts.print.print(4096UL << sdhc->BSR.bit.BOUNDARY);
+    PRINTNL();
+
+    PRINTRAW(sdhc->BCR.reg);
+    opts.print.print("BCR:  BLKCNT=");
+    opts.print.print(sdhc->BCR.bit.BLKCNT);
+    PRINTNL();
+
+    PRINTRAW(sdhc->ACR.reg);
+    opts.print.print("ACR:  bmax=");
+    switch (sdhc->ACR.bit.BMAX) {
+        case 0x0: opts.print.print("INCR16"); break;
+        case 0x1: opts.print.print("INCR8"); break;
+        case 0x2: opts.print.print("INCR4"); break;
+        case 0x3: opts.print.print("SINGLE"); break;
+    }
+    PRINTFLAG(sdhc->ACR, B1KBDIS);
+    PRINTNL();
+
+    if (sdhc->HC1R.bit.DMASEL == 0x2 || opts.showDisabled) {
+        PRINTRAW(sdhc->ASAR[0].reg);
+        opts.print.print("ASAR:  ");
+        PRINTHEX(sdhc->ASAR[0].reg);
+        opts.print.print(" ERRST=");
+        PRINTHEX(sdhc->AESR.bit.ERRST);
+        PRINTFLAG(sdhc->AESR, LMIS);
+        PRINTNL();
+    }
+
+    opts.print.print("PSR: ");
+    PRINTFLAG(sdhc->PSR, CARDINS);
+    PRINTFLAG(sdhc->PSR, CARDSS);
+    PRINTFLAG(sdhc->PSR, WRPPL);
+    PRINTFLAG(sdhc->PSR, CMDINHC);
+    PRINTFLAG(sdhc->PSR, CMDINHD);
+    PRINTFLAG(sdhc->PSR, DLACT);
+    PRINTNL();
+
+    // Theoretical bus throughput, ignoring command and CRC overhead.  DDR50
+    // (UHSMS=0x4) moves data on both edges.
+    float bytesPerSec = (float) sdclk * width / 8;
+    if (sdhc->HC2R.bit.UHSMS == 0x4) {
+        bytesPerSec *= 2;
+    }
+    opts.print.print("CARD:  width=");
+    opts.print.print(width);
+    opts.print.print(" rate=");
+    if (sdclk && sdhc->CCR.bit.SDCLKEN) {
+        opts.print.print(bytesPerSec / 1000000.0, 2);
+        opts.print.print("MB/s");
+    } else {
+        opts.print.print("?");
+    }
+    PRINTNL();
+}
+#endif
+
+
+// roles a SERCOM pad can have, indexes FourRegsSERCOM_ROLEs
+enum {
+    FourRegsSERCOM_NONE = 0,
+    FourRegsSERCOM_USART_RX,
+    FourRegsSERCOM_USART_TX,
+    FourRegsSERCOM_USART_XCK,
+    FourRegsSERCOM_USART_RTS,
+    FourRegsSERCOM_USART_CTS,
+    FourRegsSERCOM_SPI_MISO,
+    FourRegsSERCOM_SPI_MOSI,
+    FourRegsSERCOM_SPI_SCK,
+    FourRegsSERCOM_SPI_SS,
+    FourRegsSERCOM_I2C_SDA,
+    FourRegsSERCOM_I2C_SCL,
+    FourRegsSERCOM_I2C_SDAOUT,
+    FourRegsSERCOM_I2C_SCLOUT,
+};
+static const char* const FourRegsSERCOM_ROLEs[] = {
+    NULL,
+    FourRegs__usart_rx, FourRegs__usart_tx, FourRegs__usart_xck, FourRegs__usart_rts, FourRegs__usart_cts,
+    FourRegs__spi_miso, FourRegs__spi_mosi, FourRegs__spi_sck, FourRegs__spi_ss,
+    FourRegs__i2c_sda, FourRegs__i2c_scl, FourRegs__i2c_sdaout, FourRegs__i2c_sclout,
+};
+
+// Role of each pad of each SERCOM.  Filled in by fourRegsSERCOM_loadPads()
+// at the start of printFourRegPORT() and printFourRegSERCOM() so that the
+// pin hints don't need to decode CTRLA/CTRLB for every pin.
+static uint8_t FourRegsSERCOM_pads[8][4];
+
+void fourRegsSERCOM_loadPads(uint8_t idx) {
+    uint8_t* pads = FourRegsSERCOM_pads[idx];
+    memset(pads, FourRegsSERCOM_NONE, 4);
+    Sercom* sercom = fourRegsSERCOM(idx);
+    if (!sercom) {
+        return;
+    }
+    uint8_t mode = sercom->I2CM.CTRLA.bit.MODE;
+    switch (mode) {
+        case 0x0:
+        case 0x1:
+            // USART (external or internal clock)
+            pads[sercom->USART.CTRLA.bit.RXPO] = FourRegsSERCOM_USART_RX;
             switch (sercom->USART.CTRLA.bit.TXPO) {
                 case 0x0:
-                    pads[0] = FourRegs__usart_tx;
+                    pads[0] = FourRegsSERCOM_USART_TX;
+                    if (mode == 0x0) {
+                        pads[1] = FourRegsSERCOM_USART_XCK;
+                    }
                     break;
                 case 0x1:
-                    pads[2] = FourRegs__usart_tx;
+                    // reserved on SAMD51
                     break;
                 case 0x2:
-                    pads[0] = FourRegs__usart_tx;
-                    pads[2] = FourRegs__usart_rts;
-                    pads[2] = FourRegs__usart_cts;
+                    pads[0] = FourRegsSERCOM_USART_TX;
+                    pads[2] = FourRegsSERCOM_USART_RTS;
+                    pads[3] = FourRegsSERCOM_USART_CTS;
+                    break;
+                case 0x3:
+                    // RS485, RTS is the transmit enable
+                    pads[0] = FourRegsSERCOM_USART_TX;
+                    if (mode == 0x0) {
+                        pads[1] = FourRegsSERCOM_USART_XCK;
+                    }
+                    pads[2] = FourRegsSERCOM_USART_RTS;
                     break;
             }
             break;
         case 0x2:
             // SPI slave
-            switch (sercom->SPI.CTRLA.bit.DIPO) {
-                case 0x0: pads[0] = FourRegs__spi_mosi; break;
-                case 0x1: pads[1] = FourRegs__spi_mosi; break;
-                case 0x2: pads[2] = FourRegs__spi_mosi; break;
-                case 0x3: pads[3] = FourRegs__spi_mosi; break;
-            }
+            pads[sercom->SPI.CTRLA.bit.DIPO] = FourRegsSERCOM_SPI_MOSI;
             switch (sercom->SPI.CTRLA.bit.DOPO) {
                 case 0x0:
-                    pads[0] = FourRegs__spi_miso;
-                    pads[1] = FourRegs__spi_sck;
-                    pads[2] = FourRegs__spi_ss;
-                    break;
-                case 0x1:
-                    pads[2] = FourRegs__spi_miso;
-                    pads[3] = FourRegs__spi_sck;
-                    pads[1] = FourRegs__spi_ss;
+                    pads[0] = FourRegsSERCOM_SPI_MISO;
+                    pads[1] = FourRegsSERCOM_SPI_SCK;
+                    pads[2] = FourRegsSERCOM_SPI_SS;
                     break;
                 case 0x2:
-                    pads[3] = FourRegs__spi_miso;
-                    pads[1] = FourRegs__spi_sck;
-                    pads[2] = FourRegs__spi_ss;
-                    break;
-                case 0x3:
-                    pads[0] = FourRegs__spi_miso;
-                    pads[3] = FourRegs__spi_sck;
-                    pads[1] = FourRegs__spi_ss;
+                    pads[3] = FourRegsSERCOM_SPI_MISO;
+                    pads[1] = FourRegsSERCOM_SPI_SCK;
+                    pads[2] = FourRegsSERCOM_SPI_SS;
                     break;
+                // 0x1 and 0x3 are reserved on SAMD51
             }
             break;
         case 0x3:
             // SPI master
-            switch (sercom->SPI.CTRLA.bit.DIPO) {
-                case 0x0: pads[0] = FourRegs__spi_miso; break;
-                case 0x1: pads[1] = FourRegs__spi_miso; break;
-                case 0x2: pads[2] = FourRegs__spi_miso; break;
-                case 0x3: pads[3] = FourRegs__spi_miso; break;
-            }
+            pads[sercom->SPI.CTRLA.bit.DIPO] = FourRegsSERCOM_SPI_MISO;
             switch (sercom->SPI.CTRLA.bit.DOPO) {
                 case 0x0:
-                    pads[0] = FourRegs__spi_mosi;
-                    pads[1] = FourRegs__spi_sck;
-                    if (sercom->SPI.CTRLB.bit.MSSEN) {
-                        pads[2] = FourRegs__spi_ss;
-                    }
-                    break;
-                case 0x1:
-                    pads[2] = FourRegs__spi_mosi;
-                    pads[3] = FourRegs__spi_sck;
+                    pads[0] = FourRegsSERCOM_SPI_MOSI;
+                    pads[1] = FourRegsSERCOM_SPI_SCK;
                     if (sercom->SPI.CTRLB.bit.MSSEN) {
-                        pads[1] = FourRegs__spi_ss;
+                        pads[2] = FourRegsSERCOM_SPI_SS;
                     }
                     break;
                 case 0x2:
-                    pads[3] = FourRegs__spi_mosi;
-                    pads[1] = FourRegs__spi_sck;
-                    if (sercom->SPI.CTRLB.bit.MSSEN) {
-                        pads[2] = FourRegs__spi_ss;
-                    }
-                    break;
-                case 0x3:
-                    pads[0] = FourRegs__spi_mosi;
-                    pads[3] = FourRegs__spi_sck;
+                    pads[3] = FourRegsSERCOM_SPI_MOSI;
+                    pads[1] = FourRegsSERCOM_SPI_SCK;
                     if (sercom->SPI.CTRLB.bit.MSSEN) {
-                        pads[1] = FourRegs__spi_ss;
+                        pads[2] = FourRegsSERCOM_SPI_SS;
                     }
                     break;
+                // 0x1 and 0x3 are reserved on SAMD51
             }
             break;
         case 0x4:
         case 0x5:
-            // I2S (master or slave)
-            pads[0] = FourRegs__i2c_sda;
-            pads[1] = FourRegs__i2c_scl;
-            pads[2] = FourRegs__i2c_sdaout;
-            pads[3] = FourRegs__i2c_sclout;
+            // I2C (slave or master)
+            pads[0] = FourRegsSERCOM_I2C_SDA;
+            pads[1] = FourRegsSERCOM_I2C_SCL;
+            pads[2] = FourRegsSERCOM_I2C_SDAOUT;
+            pads[3] = FourRegsSERCOM_I2C_SCLOUT;
             break;
-        default:
-            return;
     }
-    if (pads[y]) {
+}
+
+void fourRegsSERCOM_loadPads() {
+    for (uint8_t idx = 0; idx < 8; idx++) {
+        fourRegsSERCOM_loadPads(idx);
+    }
+}
+
+// `pmux` is a string "SERCOMx:y"
+uint8_t fourRegsSERCOM_padRole(const char* pmux) {
+    return FourRegsSERCOM_pads[(pmux[6] - '0') & 0x7][(pmux[8] - '0') & 0x3];
+}
+
+void printFourRegSERCOM_pinhint(FourRegOptions &opts, const char* pmux) {
+    if (!pmux) {
+        return;
+    }
+    uint8_t role = fourRegsSERCOM_padRole(pmux);
+    if (role) {
         opts.print.print("(");
-        opts.print.print(pads[y]);
+        opts.print.print(FourRegsSERCOM_ROLEs[role]);
         opts.print.print(")");
     }
 }
 
 void printFourRegSERCOM_I2CM(FourRegOptions &opts, SercomI2cm &i2cm) {
+    PRINTRAW(i2cm.CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(i2cm.CTRLA, ENABLE);
     PRINTFLAG(i2cm.CTRLA, RUNSTDBY);
@@ -3179,6 +5422,7 @@ void printFourRegSERCOM_I2CM(FourRegOptions &opts, SercomI2cm &i2cm) {
     PRINTFLAG(i2cm.CTRLA, LOWTOUTEN);
     PRINTNL();
 
+    PRINTRAW(i2cm.CTRLB.reg);
     opts.print.print("CTRLB: ");
     PRINTFLAG(i2cm.CTRLB, SMEN);
     PRINTFLAG(i2cm.CTRLB, QCEN);
@@ -3186,10 +5430,12 @@ void printFourRegSERCOM_I2CM(FourRegOptions &opts, SercomI2cm &i2cm) {
     opts.print.print(i2cm.CTRLB.bit.ACKACT ? "NACK" : "ACK");
     PRINTNL();
 
+    PRINTRAW(i2cm.CTRLC.reg);
     opts.print.print("CTRLC: ");
     PRINTFLAG(i2cm.CTRLC, DATA32B);
     PRINTNL();
 
+    PRINTRAW(i2cm.BAUD.reg);
     opts.print.print("BAUD: ");
     opts.print.print(" BAUD=");
     PRINTHEX(i2cm.BAUD.bit.BAUD);
@@ -3203,6 +5449,7 @@ void printFourRegSERCOM_I2CM(FourRegOptions &opts, SercomI2cm &i2cm) {
 }
 
 void printFourRegSERCOM_I2CS(FourRegOptions &opts, SercomI2cs &i2cs) {
+    PRINTRAW(i2cs.CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(i2cs.CTRLA, ENABLE);
     PRINTFLAG(i2cs.CTRLA, RUNSTDBY);
@@ -3216,6 +5463,7 @@ void printFourRegSERCOM_I2CS(FourRegOptions &opts, SercomI2cs &i2cs) {
     PRINTFLAG(i2cs.CTRLA, LOWTOUTEN);
     PRINTNL();
 
+    PRINTRAW(i2cs.CTRLB.reg);
     opts.print.print("CTRLB: ");
     PRINTFLAG(i2cs.CTRLB, SMEN);
     PRINTFLAG(i2cs.CTRLB, GCMD);
@@ -3226,6 +5474,7 @@ void printFourRegSERCOM_I2CS(FourRegOptions &opts, SercomI2cs &i2cs) {
     opts.print.print(i2cs.CTRLB.bit.ACKACT ? "NACK" : "ACK");
     PRINTNL();
 
+    PRINTRAW(i2cs.CTRLC.reg);
     opts.print.print("CTRLC: ");
     opts.print.print(" SDASETUP=");
     PRINTHEX(i2cs.CTRLC.bit.SDASETUP);
@@ -3234,6 +5483,7 @@ void printFourRegSERCOM_I2CS(FourRegOptions &opts, SercomI2cs &i2cs) {
 }
 
 void printFourRegSERCOM_SPI(FourRegOptions &opts, SercomSpi &spi, bool master) {
+    PRINTRAW(spi.CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(spi.CTRLA, ENABLE);
     PRINTFLAG(spi.CTRLA, RUNSTDBY);
@@ -3279,6 +5529,7 @@ void printFourRegSERCOM_SPI(FourRegOptions &opts, SercomSpi &spi, bool master) {
     opts.print.print(spi.CTRLA.bit.DORD ? "LSB" : "MSB");
     PRINTNL();
 
+    PRINTRAW(spi.CTRLB.reg);
     opts.print.print("CTRLB: ");
     opts.print.print(" chsize=");
     switch (spi.CTRLB.bit.CHSIZE) {
@@ -3299,17 +5550,20 @@ void printFourRegSERCOM_SPI(FourRegOptions &opts, SercomSpi &spi, bool master) {
     PRINTFLAG(spi.CTRLB, RXEN);
     PRINTNL();
 
+    PRINTRAW(spi.CTRLC.reg);
     opts.print.print("CTRLC: ");
     opts.print.print(" ICSPACE=");
     opts.print.print(spi.CTRLC.bit.ICSPACE);
     PRINTFLAG(spi.CTRLC, DATA32B);
     PRINTNL();
 
+    PRINTRAW(spi.BAUD.reg);
     opts.print.print("BAUD:  ");
     PRINTHEX(spi.BAUD.bit.BAUD);
     PRINTNL();
 
     if (spi.CTRLA.bit.FORM == 0x2) {
+        PRINTRAW(spi.ADDR.reg);
         opts.print.print("ADDR: ");
         opts.print.print(" ADDR=");
         PRINTHEX(spi.ADDR.bit.ADDR);
@@ -3320,6 +5574,7 @@ void printFourRegSERCOM_SPI(FourRegOptions &opts, SercomSpi &spi, bool master) {
 }
 
 void printFourRegSERCOM_USART(FourRegOptions &opts, SercomUsart &usart) {
+    PRINTRAW(usart.CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(usart.CTRLA, ENABLE);
     PRINTFLAG(usart.CTRLA, RUNSTDBY);
@@ -3371,6 +5626,7 @@ void printFourRegSERCOM_USART(FourRegOptions &opts, SercomUsart &usart) {
     PRINTNL();
 
     while (usart.SYNCBUSY.bit.CTRLB) {}
+    PRINTRAW(usart.CTRLB.reg);
     opts.print.print("CTRLB:  chsize=");
     switch (usart.CTRLB.bit.CHSIZE) {
         case 0x0: opts.print.print("8bit"); break;
@@ -3396,6 +5652,7 @@ void printFourRegSERCOM_USART(FourRegOptions &opts, SercomUsart &usart) {
     PRINTHEX(usart.CTRLB.bit.LINCMD);
     PRINTNL();
 
+    PRINTRAW(usart.CTRLC.reg);
     opts.print.print("CTRLC: ");
     switch (usart.CTRLA.bit.FORM) {
         case 0x0:
@@ -3423,6 +5680,7 @@ void printFourRegSERCOM_USART(FourRegOptions &opts, SercomUsart &usart) {
     PRINTHEX(usart.CTRLC.bit.DATA32B);
     PRINTNL();
 
+    PRINTRAW(usart.BAUD.reg);
     opts.print.print("BAUD:  ");
     if (arithbaud) {
         opts.print.print(usart.BAUD.bit.BAUD);
@@ -3434,6 +5692,7 @@ void printFourRegSERCOM_USART(FourRegOptions &opts, SercomUsart &usart) {
     PRINTNL();
 
     if (usart.CTRLB.bit.ENC) {
+        PRINTRAW(usart.RXPL.reg);
         opts.print.print("RXPL:  ");
         PRINTHEX(usart.RXPL.bit.RXPL);
         PRINTNL();
@@ -3481,8 +5740,43 @@ void printFourRegSERCOM(FourRegOptions &opts, Sercom* sercom, uint8_t idx) {
         default:
             opts.print.print(" ");
             opts.print.println(FourRegs__RESERVED);
-            break;
+            return;
+    }
+
+    fourRegsSERCOM_loadPads(idx);
+    // pins muxed to each pad (PMUX C or D), 0xFF if none
+    uint8_t padGids[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    uint8_t padPids[4];
+    for (uint8_t gid = 0; gid < fourRegsPORTGroups(); gid++) {
+        for (uint8_t pid = 0; pid < 32; pid++) {
+            uint8_t sel = fourRegsPORT_pmux(gid, pid);
+            if (sel != 0x2 && sel != 0x3) {
+                continue;
+            }
+            const char* func = fourRegsPORT_func(gid, pid, sel);
+            if (func && strncmp(func, "SERCOM", 6) == 0 && func[6] - '0' == idx) {
+                uint8_t pad = (func[8] - '0') & 0x3;
+                padGids[pad] = gid;
+                padPids[pad] = pid;
+            }
+        }
     }
+    opts.print.print("PADS: ");
+    for (uint8_t pad = 0; pad < 4; pad++) {
+        uint8_t role = FourRegsSERCOM_pads[idx][pad];
+        if (role) {
+            opts.print.print(" pad");
+            opts.print.print(pad);
+            opts.print.print("=");
+            opts.print.print(FourRegsSERCOM_ROLEs[role]);
+            if (padGids[pad] != 0xFF) {
+                opts.print.print("@");
+                opts.print.print(FourRegsPORT_pins[padGids[pad]][padPids[pad]].name);
+                printFourReg_ARDUINO(opts, padGids[pad], padPids[pad], ":D");
+            }
+        }
+    }
+    PRINTNL();
 }
 
 
@@ -3490,6 +5784,7 @@ void printFourRegSUPC(FourRegOptions &opts) {
     opts.print.println("--------------------------- SUPC");
 
     if (opts.showDisabled || SUPC->BOD33.bit.ENABLE) {
+        PRINTRAW(SUPC->BOD33.reg);
         opts.print.print("BOD33: ");
         PRINTFLAG(SUPC->BOD33, ENABLE);
         opts.print.print(" ACTION=");
@@ -3515,6 +5810,7 @@ void printFourRegSUPC(FourRegOptions &opts) {
     }
 
     if (opts.showDisabled || SUPC->BOD12.bit.ENABLE) {
+        PRINTRAW(SUPC->BOD12.reg);
         opts.print.print("BOD12: ");
         PRINTFLAG(SUPC->BOD12, ENABLE);
         PRINTFLAG(SUPC->BOD12, HYST);
@@ -3536,6 +5832,7 @@ void printFourRegSUPC(FourRegOptions &opts) {
     }
 
     if (opts.showDisabled || SUPC->VREG.bit.ENABLE) {
+        PRINTRAW(SUPC->VREG.reg);
         opts.print.print("VREG: ");
         PRINTFLAG(SUPC->VREG, ENABLE);
         PRINTFLAG(SUPC->VREG, SEL);
@@ -3551,6 +5848,7 @@ void printFourRegSUPC(FourRegOptions &opts) {
         }
     }
 
+    PRINTRAW(SUPC->VREF.reg);
     opts.print.print("VREF: ");
     PRINTFLAG(SUPC->VREF, TSEN);
     PRINTFLAG(SUPC->VREF, VREFOE);
@@ -3561,12 +5859,14 @@ void printFourRegSUPC(FourRegOptions &opts) {
     PRINTHEX(SUPC->VREF.bit.SEL);
     PRINTNL();
 
+    PRINTRAW(SUPC->BBPS.reg);
     opts.print.print("BBPS: ");
     PRINTFLAG(SUPC->BBPS, CONF);
     PRINTFLAG(SUPC->BBPS, WAKEEN);
     PRINTNL();
 
     if (opts.showDisabled || SUPC->BKOUT.bit.EN) {
+        PRINTRAW(SUPC->BKOUT.reg);
         opts.print.print("BKOUT: ");
         if (SUPC->BKOUT.bit.EN & 0x1) {
             opts.print.print(" 1=EN");
@@ -3588,6 +5888,7 @@ void printFourRegSUPC(FourRegOptions &opts) {
         }
     }
 
+    PRINTRAW(SUPC->BKIN.reg);
     opts.print.print("BKIN:  ");
     PRINTHEX(SUPC->BKIN.bit.BKIN);
     PRINTNL();
@@ -3683,6 +5984,7 @@ void printFourRegTC_8(FourRegOptions &opts, TcCount8& tc, uint8_t idx) {
     printFourRegTC_WAVE(opts, tc.WAVE);
     printFourRegTC_DRVCTRL(opts, tc.DRVCTRL);
     while (tc.SYNCBUSY.bit.PER) {}
+    PRINTRAW(tc.PER.reg);
     opts.print.print("PER:  ");
     opts.print.println(tc.PER.bit.PER);
     while (tc.SYNCBUSY.bit.CC0) {}
@@ -3784,6 +6086,7 @@ void printFourRegTCC(FourRegOptions &opts, Tcc* tcc, uint8_t idx) {
     opts.print.print("--------------------------- TCC");
     opts.print.println(idx);
 
+    PRINTRAW(tcc->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(tcc->CTRLA, ENABLE);
     PRINTFLAG(tcc->CTRLA, RUNSTDBY);
@@ -3819,9 +6122,11 @@ void printFourRegTCC(FourRegOptions &opts, Tcc* tcc, uint8_t idx) {
     for (id = 0; id < 2; id++) {
         FourRegsTCC_FCTRL_Type fctrl;
         if (id == 0) {
+            PRINTRAW(tcc->FCTRLA.reg);
             opts.print.print("FCTRLA: ");
             COPYVOL(fctrl, tcc->FCTRLA);
         } else {
+            PRINTRAW(tcc->FCTRLB.reg);
             opts.print.print("FCTRLB: ");
             COPYVOL(fctrl, tcc->FCTRLB);
         }
@@ -3846,6 +6151,7 @@ void printFourRegTCC(FourRegOptions &opts, Tcc* tcc, uint8_t idx) {
         PRINTNL();
     }
 
+    PRINTRAW(tcc->WEXCTRL.reg);
     opts.print.print("WEXCTRL: ");
     opts.print.print(" OTMX=");
     PRINTHEX(tcc->WEXCTRL.bit.OTMX);
@@ -3859,6 +6165,7 @@ void printFourRegTCC(FourRegOptions &opts, Tcc* tcc, uint8_t idx) {
     opts.print.print(tcc->WEXCTRL.bit.DTHS);
     PRINTNL();
 
+    PRINTRAW(tcc->DRVCTRL.reg);
     opts.print.print("DRVCTRL: ");
     for (id = 0; id < 8; id++) {
         if (tcc->DRVCTRL.vec.NRE & (1<<id)) {
@@ -3884,6 +6191,7 @@ void printFourRegTCC(FourRegOptions &opts, Tcc* tcc, uint8_t idx) {
     PRINTHEX(tcc->DRVCTRL.bit.FILTERVAL1);
     PRINTNL();
 
+    PRINTRAW(tcc->EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     opts.print.print(" EVACT0=");
     PRINTHEX(tcc->EVCTRL.bit.EVACT0);
@@ -3911,6 +6219,7 @@ void printFourRegTCC(FourRegOptions &opts, Tcc* tcc, uint8_t idx) {
     PRINTNL();
 
     while (tcc->SYNCBUSY.bit.PATT) {}
+    PRINTRAW(tcc->PATT.reg);
     opts.print.print("PATT:  ");
     for (id = 0; id < 8; id++) {
         if (tcc->PATT.vec.PGE & (1<<id)) {
@@ -3922,6 +6231,7 @@ void printFourRegTCC(FourRegOptions &opts, Tcc* tcc, uint8_t idx) {
     PRINTNL();
 
     while (tcc->SYNCBUSY.bit.WAVE) {}
+    PRINTRAW(tcc->WAVE.reg);
     opts.print.print("WAVE: ");
     opts.print.print(" WAVEGEN=");
     PRINTHEX(tcc->WAVE.bit.WAVEGEN);
@@ -3949,6 +6259,7 @@ void printFourRegTCC(FourRegOptions &opts, Tcc* tcc, uint8_t idx) {
     PRINTNL();
 
     while (tcc->SYNCBUSY.bit.PER) {}
+    PRINTRAW(tcc->PER.reg);
     opts.print.print("PER:  ");
     switch (dith) {
         case 0x0:
@@ -4008,11 +6319,13 @@ void printFourRegTRNG(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- TRNG");
 
+    PRINTRAW(TRNG->CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(TRNG->CTRLA, ENABLE);
     PRINTFLAG(TRNG->CTRLA, RUNSTDBY);
     PRINTNL();
 
+    PRINTRAW(TRNG->EVCTRL.reg);
     opts.print.print("EVCTRL: ");
     PRINTFLAG(TRNG->EVCTRL, DATARDYEO);
     PRINTNL();
@@ -4063,6 +6376,7 @@ void printFourRegUSB_DESCADD(FourRegOptions &opts, uint8_t n, uint8_t b, bool is
 }
 
 void printFourRegUSB_DEVICE(FourRegOptions &opts, UsbDevice &dev) {
+    PRINTRAW(dev.CTRLB.reg);
     opts.print.print("CTRLB: ");
     PRINTFLAG(dev.CTRLB, DETACH);
     opts.print.print(" spdconf=");
@@ -4082,6 +6396,7 @@ void printFourRegUSB_DEVICE(FourRegOptions &opts, UsbDevice &dev) {
     PRINTHEX(dev.CTRLB.bit.LPMHDSK);
     PRINTNL();
 
+    PRINTRAW(dev.DADD.reg);
     opts.print.print("DADD:  ");
     PRINTHEX(dev.DADD.bit.DADD);
     PRINTFLAG(dev.DADD, ADDEN);
@@ -4139,6 +6454,7 @@ void printFourRegUSB_DEVICE(FourRegOptions &opts, UsbDevice &dev) {
 }
 
 void printFourRegUSB_HOST(FourRegOptions &opts, UsbHost &host) {
+    PRINTRAW(host.CTRLB.reg);
     opts.print.print("CTRLB:  SPDCONF=");
     PRINTHEX(host.CTRLB.bit.SPDCONF);
     PRINTFLAG(host.CTRLB, AUTORESUME);
@@ -4148,6 +6464,7 @@ void printFourRegUSB_HOST(FourRegOptions &opts, UsbHost &host) {
     PRINTFLAG(host.CTRLB, SOFE);
     PRINTNL();
 
+    PRINTRAW(host.HSOFC.reg);
     opts.print.print("HSOFC:  FLENC=");
     PRINTHEX(host.HSOFC.bit.FLENC);
     PRINTFLAG(host.HSOFC, FLENCE);
@@ -4198,6 +6515,7 @@ void printFourRegUSB(FourRegOptions &opts) {
     }
     opts.print.println("--------------------------- USB");
 
+    PRINTRAW(USB->DEVICE.CTRLA.reg);
     opts.print.print("CTRLA: ");
     PRINTFLAG(USB->DEVICE.CTRLA, ENABLE);
     PRINTFLAG(USB->DEVICE.CTRLA, RUNSTDBY);
@@ -4205,6 +6523,7 @@ void printFourRegUSB(FourRegOptions &opts) {
     opts.print.print(USB->DEVICE.CTRLA.bit.MODE ? "HOST" : "DEVICE");
     PRINTNL();
 
+    PRINTRAW(USB->DEVICE.QOSCTRL.reg);
     opts.print.print("QOSCTRL:  cqos=");
     printFourReg_QOS(opts, USB->DEVICE.QOSCTRL.bit.CQOS);
     opts.print.print(" dqos=");
@@ -4233,95 +6552,1887 @@ void printFourRegWDT(FourRegOptions &opts) {
     PRINTFLAG(ctrla, WEN);
     PRINTFLAG(ctrla, ALWAYSON);
 
+    PRINTRAW(WDT->CONFIG.reg);
     opts.print.print("CONFIG:  WINDOW=");
     PRINTHEX(WDT->CONFIG.bit.WINDOW);
     opts.print.print("PER=");
     PRINTHEX(WDT->CONFIG.bit.PER);
     PRINTNL();
 
+    PRINTRAW(WDT->EWCTRL.reg);
     opts.print.print("EWCTRL:  EWOFFSET=");
     PRINTHEX(WDT->EWCTRL.bit.EWOFFSET);
     PRINTNL();
 }
 
 
-void printFourRegs(FourRegOptions &opts) {
-    // show system basics
-    printFourRegSCS(opts);
-    printFourRegOSCCTRL(opts);
-    printFourRegOSC32KCTRL(opts);
-    printFourRegGCLK(opts);
-    printFourRegMCLK(opts);
-    printFourRegRTC(opts);
-
-    // show core peripherals
-    printFourRegCMCC(opts);
-    //FUTURE printFourRegDSU(opts);
-    printFourRegDMAC(opts);
-    printFourRegEVSYS(opts);
-    printFourRegPAC(opts);
-    printFourRegPM(opts);
-    printFourRegSUPC(opts);
-    printFourRegWDT(opts);
-
-    // show other peripherals
-    printFourRegAC(opts);
-    printFourRegADC(opts, ADC0, 0);
-    printFourRegADC(opts, ADC1, 1);
-    printFourRegAES(opts);
-    //FUTURE printFourRegCAN(opts);
-    printFourRegCCL(opts);
-    printFourRegDAC(opts);
-    printFourRegEIC(opts);
-    printFourRegFREQM(opts);
-#ifdef I2S
-    printFourRegI2S(opts);
-#endif
-    printFourRegICM(opts);
-    printFourRegNVMCTRL(opts);
-    printFourRegPCC(opts);
-    printFourRegPDEC(opts);
-    printFourRegPORT(opts);
-    printFourRegQSPI(opts);
-    printFourRegSERCOM(opts, SERCOM0, 0);
-    printFourRegSERCOM(opts, SERCOM1, 1);
-    printFourRegSERCOM(opts, SERCOM2, 2);
-    printFourRegSERCOM(opts, SERCOM3, 3);
-    printFourRegSERCOM(opts, SERCOM4, 4);
-    printFourRegSERCOM(opts, SERCOM5, 5);
-#ifdef SERCOM6
-    printFourRegSERCOM(opts, SERCOM6, 6);
-#endif
-#ifdef SERCOM7
-    printFourRegSERCOM(opts, SERCOM7, 7);
-#endif
-    printFourRegTCC(opts, TCC0, 0);
-    printFourRegTCC(opts, TCC1, 1);
-    printFourRegTCC(opts, TCC2, 2);
-#ifdef TCC3
-    printFourRegTCC(opts, TCC3, 3);
-#endif
-#ifdef TCC4
-    printFourRegTCC(opts, TCC4, 4);
-#endif
-    printFourRegTC(opts, TC0, 0);
-    printFourRegTC(opts, TC1, 1);
-    printFourRegTC(opts, TC2, 2);
-    printFourRegTC(opts, TC3, 3);
-#ifdef TC4
-    printFourRegTC(opts, TC4, 4);
-#endif
-#ifdef TC5
-    printFourRegTC(opts, TC5, 5);
+// CRC-32 (same polynomial as zlib) a nibble at a time, so the table is small
+static const uint32_t FourRegsCRC32_nibbles[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t fourRegsCRC32(uint32_t crc, uint32_t val) {
+    for (uint8_t n = 0; n < 8; n++) {
+        crc = (crc >> 4) ^ FourRegsCRC32_nibbles[(crc ^ val) & 0xF];
+        val >>= 4;
+    }
+    return crc;
+}
+
+// Each of these hashes the configuration registers of a peripheral.
+// Status, counter, and data registers are left out, as are configuration
+// registers which drivers normally rewrite while running (such as the ADC
+// input mux or TC compare values).
+#define FINGERPRINT(x) do { crc = fourRegsCRC32(crc, (x)); } while(0)
+
+uint32_t fourRegsFingerprintAC(uint32_t crc) {
+    FINGERPRINT(AC->CTRLA.reg);
+    FINGERPRINT(AC->EVCTRL.reg);
+    FINGERPRINT(AC->WINCTRL.reg);
+    FINGERPRINT(AC->SCALER[0].reg);
+    FINGERPRINT(AC->SCALER[1].reg);
+    for (uint8_t id = 0; id < 2; id++) {
+        FINGERPRINT(AC->COMPCTRL[id].reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintADC(uint32_t crc) {
+    Adc* adcs[2] = { ADC0, ADC1 };
+    for (uint8_t idx = 0; idx < 2; idx++) {
+        // ENABLE is masked since analogRead() turns the ADC on and off
+        FINGERPRINT(adcs[idx]->CTRLA.reg & ~ADC_CTRLA_ENABLE);
+        FINGERPRINT(adcs[idx]->CTRLB.reg);
+        FINGERPRINT(adcs[idx]->REFCTRL.reg);
+        FINGERPRINT(adcs[idx]->AVGCTRL.reg);
+        FINGERPRINT(adcs[idx]->SAMPCTRL.reg);
+        FINGERPRINT(adcs[idx]->WINLT.reg);
+        FINGERPRINT(adcs[idx]->WINUT.reg);
+        FINGERPRINT(adcs[idx]->GAINCORR.reg);
+        FINGERPRINT(adcs[idx]->OFFSETCORR.reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintAES(uint32_t crc) {
+    FINGERPRINT(AES->CTRLA.reg);
+    return crc;
+}
+
+#ifdef CAN0
+uint32_t fourRegsFingerprintCAN(uint32_t crc) {
+#ifdef CAN1
+    Can* cans[2] = { CAN0, CAN1 };
+#else
+    Can* cans[1] = { CAN0 };
 #endif
-#ifdef TC6
-    printFourRegTC(opts, TC6, 6);
+    for (uint8_t idx = 0; idx < sizeof(cans) / sizeof(cans[0]); idx++) {
+        FINGERPRINT(cans[idx]->CCCR.reg);
+        FINGERPRINT(cans[idx]->NBTP.reg);
+        FINGERPRINT(cans[idx]->DBTP.reg);
+        FINGERPRINT(cans[idx]->MRCFG.reg);
+        FINGERPRINT(cans[idx]->GFC.reg);
+        FINGERPRINT(cans[idx]->SIDFC.reg);
+        FINGERPRINT(cans[idx]->XIDFC.reg);
+        FINGERPRINT(cans[idx]->RXF0C.reg);
+        FINGERPRINT(cans[idx]->RXF1C.reg);
+        FINGERPRINT(cans[idx]->RXBC.reg);
+        FINGERPRINT(cans[idx]->RXESC.reg);
+        FINGERPRINT(cans[idx]->TXBC.reg);
+        FINGERPRINT(cans[idx]->TXESC.reg);
+        FINGERPRINT(cans[idx]->TXEFC.reg);
+    }
+    return crc;
+}
 #endif
-#ifdef TC7
-    printFourRegTC(opts, TC7, 7);
+
+uint32_t fourRegsFingerprintCCL(uint32_t crc) {
+    FINGERPRINT(CCL->CTRL.reg);
+    for (uint8_t i = 0; i < 2; i++) {
+        FINGERPRINT(CCL->SEQCTRL[i].reg);
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        FINGERPRINT(CCL->LUTCTRL[i].reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintCMCC(uint32_t crc) {
+    FINGERPRINT(CMCC->CFG.reg);
+    FINGERPRINT(CMCC->SR.bit.CSTS);
+    FINGERPRINT(CMCC->LCKWAY.reg);
+    FINGERPRINT(CMCC->MCFG.reg);
+    FINGERPRINT(CMCC->MEN.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintDAC(uint32_t crc) {
+    FINGERPRINT(DAC->CTRLA.reg);
+    FINGERPRINT(DAC->CTRLB.reg);
+    FINGERPRINT(DAC->EVCTRL.reg);
+    for (uint8_t i = 0; i < 2; i++) {
+        FINGERPRINT(DAC->DACCTRL[i].reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintDMAC(uint32_t crc) {
+    FINGERPRINT(DMAC->CTRL.reg);
+    FINGERPRINT(DMAC->CRCCTRL.reg);
+    FINGERPRINT(DMAC->PRICTRL0.reg);
+    for (uint8_t id = 0; id < 32; id++) {
+        // ENABLE is masked since the DMAC clears it at the end of a transfer
+        FINGERPRINT(DMAC->Channel[id].CHCTRLA.reg & ~(DMAC_CHCTRLA_ENABLE | DMAC_CHCTRLA_SWRST));
+        FINGERPRINT(DMAC->Channel[id].CHPRILVL.reg);
+        FINGERPRINT(DMAC->Channel[id].CHEVCTRL.reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintEIC(uint32_t crc) {
+    FINGERPRINT(EIC->CTRLA.reg);
+    FINGERPRINT(EIC->NMICTRL.reg);
+    FINGERPRINT(EIC->EVCTRL.reg);
+    FINGERPRINT(EIC->INTENSET.reg);
+    FINGERPRINT(EIC->ASYNCH.reg);
+    FINGERPRINT(EIC->CONFIG[0].reg);
+    FINGERPRINT(EIC->CONFIG[1].reg);
+    FINGERPRINT(EIC->DEBOUNCEN.reg);
+    FINGERPRINT(EIC->DPRESCALER.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintEVSYS(uint32_t crc) {
+    FINGERPRINT(EVSYS->PRICTRL.reg);
+    for (uint8_t id = 0; id < 32; id++) {
+        FINGERPRINT(EVSYS->Channel[id].CHANNEL.reg);
+    }
+    for (uint8_t id = 0; id < 67; id++) {
+        FINGERPRINT(EVSYS->USER[id].reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintFREQM(uint32_t crc) {
+    FINGERPRINT(FREQM->CTRLA.reg);
+    FINGERPRINT(FREQM->CFGA.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintGCLK(uint32_t crc) {
+    for (uint8_t genid = 0; genid < 12; genid++) {
+        FINGERPRINT(GCLK->GENCTRL[genid].reg);
+    }
+    for (uint8_t pchid = 0; pchid < 48; pchid++) {
+        FINGERPRINT(GCLK->PCHCTRL[pchid].reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintHMATRIX(uint32_t crc) {
+    for (uint8_t slave = 0; slave < 16; slave++) {
+        FINGERPRINT(HMATRIX->Prs[slave].PRAS.reg);
+        FINGERPRINT(HMATRIX->Prs[slave].PRBS.reg);
+    }
+    return crc;
+}
+
+#ifdef I2S
+uint32_t fourRegsFingerprintI2S(uint32_t crc) {
+    FINGERPRINT(I2S->CTRLA.reg);
+    FINGERPRINT(I2S->CLKCTRL[0].reg);
+    FINGERPRINT(I2S->CLKCTRL[1].reg);
+    FINGERPRINT(I2S->TXCTRL.reg);
+    FINGERPRINT(I2S->RXCTRL.reg);
+    return crc;
+}
 #endif
-    printFourRegTRNG(opts);
-    printFourRegUSB(opts);
+
+uint32_t fourRegsFingerprintICM(uint32_t crc) {
+    FINGERPRINT(ICM->CFG.reg);
+    FINGERPRINT(ICM->SR.bit.ENABLE);
+    FINGERPRINT(ICM->UASR.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintMCLK(uint32_t crc) {
+    FINGERPRINT(MCLK->CPUDIV.reg);
+    FINGERPRINT(MCLK->AHBMASK.reg);
+    FINGERPRINT(MCLK->APBAMASK.reg);
+    FINGERPRINT(MCLK->APBBMASK.reg);
+    FINGERPRINT(MCLK->APBCMASK.reg);
+    FINGERPRINT(MCLK->APBDMASK.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintNVMCTRL(uint32_t crc) {
+    FINGERPRINT(NVMCTRL->CTRLA.reg);
+    FINGERPRINT(NVMCTRL->SEECFG.reg);
+    FINGERPRINT(NVMCTRL->SEESTAT.bit.SBLK);
+    FINGERPRINT(NVMCTRL->SEESTAT.bit.PSZ);
+    FINGERPRINT(NVMCTRL->STATUS.bit.BOOTPROT);
+    FINGERPRINT(NVMCTRL->RUNLOCK.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintOSC32KCTRL(uint32_t crc) {
+    FINGERPRINT(OSC32KCTRL->EVCTRL.reg);
+    FINGERPRINT(OSC32KCTRL->RTCCTRL.reg);
+    FINGERPRINT(OSC32KCTRL->XOSC32K.reg);
+    FINGERPRINT(OSC32KCTRL->CFDCTRL.reg);
+    FINGERPRINT(OSC32KCTRL->OSCULP32K.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintOSCCTRL(uint32_t crc) {
+    FINGERPRINT(OSCCTRL->EVCTRL.reg);
+    FINGERPRINT(OSCCTRL->XOSCCTRL[0].reg);
+    FINGERPRINT(OSCCTRL->XOSCCTRL[1].reg);
+    FINGERPRINT(OSCCTRL->DFLLCTRLA.reg);
+    FINGERPRINT(OSCCTRL->DFLLCTRLB.reg);
+    FINGERPRINT(OSCCTRL->DFLLMUL.reg);
+    // DFLLVAL is left out since it moves around in closed-loop mode
+    for (uint8_t id = 0; id < 2; id++) {
+        FINGERPRINT(OSCCTRL->Dpll[id].DPLLCTRLA.reg);
+        FINGERPRINT(OSCCTRL->Dpll[id].DPLLRATIO.reg);
+        FINGERPRINT(OSCCTRL->Dpll[id].DPLLCTRLB.reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintPAC(uint32_t crc) {
+    FINGERPRINT(PAC->EVCTRL.reg);
+    FINGERPRINT(PAC->STATUSA.reg);
+    FINGERPRINT(PAC->STATUSB.reg);
+    FINGERPRINT(PAC->STATUSC.reg);
+    FINGERPRINT(PAC->STATUSD.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintPCC(uint32_t crc) {
+    FINGERPRINT(PCC->MR.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintPDEC(uint32_t crc) {
+    FINGERPRINT(PDEC->CTRLA.reg);
+    FINGERPRINT(PDEC->EVCTRL.reg);
+    FINGERPRINT(PDEC->PRESC.reg);
+    FINGERPRINT(PDEC->FILTER.reg);
+    FINGERPRINT(PDEC->CC[0].reg);
+    FINGERPRINT(PDEC->CC[1].reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintPM(uint32_t crc) {
+    FINGERPRINT(PM->CTRLA.reg);
+    FINGERPRINT(PM->SLEEPCFG.reg);
+    FINGERPRINT(PM->STDBYCFG.reg);
+    FINGERPRINT(PM->HIBCFG.reg);
+    FINGERPRINT(PM->BKUPCFG.reg);
+    FINGERPRINT(PM->PWSAKDLY.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintPORT(uint32_t crc) {
+    for (uint8_t gid = 0; gid < 4; gid++) {
+        PortGroup &group = PORT->Group[gid];
+        uint32_t pulls = 0;
+        FINGERPRINT(group.DIR.reg);
+        FINGERPRINT(group.CTRL.reg);
+        FINGERPRINT(group.EVCTRL.reg);
+        for (uint8_t pid = 0; pid < 32; pid++) {
+            FINGERPRINT(group.PINCFG[pid].reg);
+            if (group.PINCFG[pid].bit.PULLEN) {
+                pulls |= 1UL << pid;
+            }
+        }
+        for (uint8_t pid = 0; pid < 16; pid++) {
+            FINGERPRINT(group.PMUX[pid].reg);
+        }
+        // OUT only counts as configuration when it chooses the pull direction
+        FINGERPRINT(group.OUT.reg & ~group.DIR.reg & pulls);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintQSPI(uint32_t crc) {
+    // INSTRFRAME is left out since drivers rewrite it for each command
+    FINGERPRINT(QSPI->STATUS.bit.ENABLE);
+    FINGERPRINT(QSPI->CTRLB.reg);
+    FINGERPRINT(QSPI->BAUD.reg);
+    FINGERPRINT(QSPI->SCRAMBCTRL.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintRTC(uint32_t crc) {
+    // the compare/alarm values are left out since they are usually the next wakeup time
+    FINGERPRINT(RTC->MODE0.CTRLA.reg);
+    FINGERPRINT(RTC->MODE0.CTRLB.reg);
+    FINGERPRINT(RTC->MODE0.EVCTRL.reg);
+    FINGERPRINT(RTC->MODE0.FREQCORR.reg);
+    FINGERPRINT(RTC->MODE0.TAMPCTRL.reg);
+    if (RTC->MODE0.CTRLA.bit.MODE == 0x1) {
+        FINGERPRINT(RTC->MODE1.PER.reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintSCS(uint32_t crc) {
+    // VTOR is left out since fourRegsIRQProfileStart() and
+    // fourRegsCrashHookInstall() move the vector table to SRAM.
+    FINGERPRINT(SCB->AIRCR & SCB_AIRCR_PRIGROUP_Msk);
+    FINGERPRINT(SCB->CCR);
+    FINGERPRINT(SysTick->CTRL & ~SysTick_CTRL_COUNTFLAG_Msk);
+    FINGERPRINT(SysTick->LOAD);
+    for (uint8_t irq = 0; irq < PERIPH_COUNT_IRQn; irq++) {
+        FINGERPRINT(NVIC_GetPriority((IRQn_Type) irq));
+    }
+    for (uint8_t n = 0; n < (PERIPH_COUNT_IRQn + 31) / 32; n++) {
+        FINGERPRINT(NVIC->ISER[n]);
+    }
+    return crc;
+}
+
+#ifdef SDHC0
+uint32_t fourRegsFingerprintSDHC(uint32_t crc) {
+#ifdef SDHC1
+    Sdhc* sdhcs[2] = { SDHC0, SDHC1 };
+#else
+    Sdhc* sdhcs[1] = { SDHC0 };
+#endif
+    for (uint8_t idx = 0; idx < sizeof(sdhcs) / sizeof(sdhcs[0]); idx++) {
+        FINGERPRINT(sdhcs[idx]->HC1R.reg);
+        FINGERPRINT(sdhcs[idx]->HC2R.reg);
+        FINGERPRINT(sdhcs[idx]->PCR.reg);
+        FINGERPRINT(sdhcs[idx]->CCR.reg);
+        FINGERPRINT(sdhcs[idx]->TCR.reg);
+        FINGERPRINT(sdhcs[idx]->ACR.reg);
+    }
+    return crc;
+}
+#endif
+
+uint32_t fourRegsFingerprintSERCOM(uint32_t crc) {
+    Sercom* sercoms[] = {
+        SERCOM0, SERCOM1, SERCOM2, SERCOM3, SERCOM4, SERCOM5,
+#ifdef SERCOM6
+        SERCOM6,
+#endif
+#ifdef SERCOM7
+        SERCOM7,
+#endif
+    };
+    for (uint8_t idx = 0; idx < sizeof(sercoms) / sizeof(sercoms[0]); idx++) {
+        Sercom* sercom = sercoms[idx];
+        uint32_t ctrlb = sercom->I2CM.CTRLB.reg;
+        if (sercom->I2CM.CTRLA.bit.MODE == 0x5) {
+            // CMD and ACKACT are used for each I2C transfer
+            ctrlb &= ~(SERCOM_I2CM_CTRLB_CMD_Msk | SERCOM_I2CM_CTRLB_ACKACT);
+        }
+        if (sercom->I2CM.CTRLA.bit.MODE == 0x4) {
+            // same for I2C slave
+            ctrlb &= ~(SERCOM_I2CS_CTRLB_CMD_Msk | SERCOM_I2CS_CTRLB_ACKACT);
+        }
+        FINGERPRINT(sercom->I2CM.CTRLA.reg);
+        FINGERPRINT(ctrlb);
+        FINGERPRINT(sercom->I2CM.CTRLC.reg);
+        // BAUD is 8, 16, or 32 bits depending on mode.  The word also covers
+        // RXPL in USART mode, which is configuration too, and reads as 0 otherwise.
+        FINGERPRINT(sercom->I2CM.BAUD.reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintSUPC(uint32_t crc) {
+    FINGERPRINT(SUPC->BOD33.reg);
+    FINGERPRINT(SUPC->BOD12.reg);
+    FINGERPRINT(SUPC->VREG.reg);
+    FINGERPRINT(SUPC->VREF.reg);
+    FINGERPRINT(SUPC->BBPS.reg);
+    FINGERPRINT(SUPC->BKOUT.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintTC(uint32_t crc) {
+    Tc* tcs[] = {
+        TC0, TC1, TC2, TC3,
+#ifdef TC4
+        TC4,
+#endif
+#ifdef TC5
+        TC5,
+#endif
+#ifdef TC6
+        TC6,
+#endif
+#ifdef TC7
+        TC7,
+#endif
+    };
+    for (uint8_t idx = 0; idx < sizeof(tcs) / sizeof(tcs[0]); idx++) {
+        TcCount8 &tc = tcs[idx]->COUNT8;
+        FINGERPRINT(tc.CTRLA.reg);
+        FINGERPRINT(tc.EVCTRL.reg);
+        FINGERPRINT(tc.WAVE.reg);
+        FINGERPRINT(tc.DRVCTRL.reg);
+        if (tc.CTRLA.bit.MODE == 0x1) {
+            FINGERPRINT(tc.PER.reg);
+        }
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintTCC(uint32_t crc) {
+    Tcc* tccs[] = {
+        TCC0, TCC1, TCC2,
+#ifdef TCC3
+        TCC3,
+#endif
+#ifdef TCC4
+        TCC4,
+#endif
+    };
+    for (uint8_t idx = 0; idx < sizeof(tccs) / sizeof(tccs[0]); idx++) {
+        Tcc* tcc = tccs[idx];
+        FINGERPRINT(tcc->CTRLA.reg);
+        FINGERPRINT(tcc->EVCTRL.reg);
+        FINGERPRINT(tcc->WAVE.reg);
+        FINGERPRINT(tcc->DRVCTRL.reg);
+        FINGERPRINT(tcc->WEXCTRL.reg);
+        FINGERPRINT(tcc->PER.reg);
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintTRNG(uint32_t crc) {
+    FINGERPRINT(TRNG->CTRLA.reg);
+    FINGERPRINT(TRNG->EVCTRL.reg);
+    return crc;
+}
+
+uint32_t fourRegsFingerprintUSB(uint32_t crc) {
+    // DADD is left out since the host assigns it
+    FINGERPRINT(USB->DEVICE.CTRLA.reg);
+    FINGERPRINT(USB->DEVICE.QOSCTRL.reg);
+    if (!USB->DEVICE.CTRLA.bit.MODE) {
+        for (uint8_t n = 0; n < 8; n++) {
+            FINGERPRINT(USB->DEVICE.DeviceEndpoint[n].EPCFG.reg);
+        }
+    }
+    return crc;
+}
+
+uint32_t fourRegsFingerprintWDT(uint32_t crc) {
+    FINGERPRINT(WDT->CTRLA.reg);
+    FINGERPRINT(WDT->CONFIG.reg);
+    FINGERPRINT(WDT->EWCTRL.reg);
+    return crc;
+}
+
+struct FourRegsFingerprint_Peripheral {
+    uint64_t    bit;
+    const char* name;
+    uint32_t    (*fingerprint)(uint32_t crc);
+};
+static const FourRegsFingerprint_Peripheral FourRegsFingerprint_peripherals[] = {
+    { FOUR_REGS_SCS,        "SCS",          fourRegsFingerprintSCS },
+    { FOUR_REGS_OSCCTRL,    "OSCCTRL",      fourRegsFingerprintOSCCTRL },
+    { FOUR_REGS_OSC32KCTRL, "OSC32KCTRL",   fourRegsFingerprintOSC32KCTRL },
+    { FOUR_REGS_GCLK,       "GCLK",         fourRegsFingerprintGCLK },
+    { FOUR_REGS_MCLK,       "MCLK",         fourRegsFingerprintMCLK },
+    { FOUR_REGS_RTC,        "RTC",          fourRegsFingerprintRTC },
+    { FOUR_REGS_CMCC,       "CMCC",         fourRegsFingerprintCMCC },
+    { FOUR_REGS_DMAC,       "DMAC",         fourRegsFingerprintDMAC },
+    { FOUR_REGS_EVSYS,      "EVSYS",        fourRegsFingerprintEVSYS },
+    { FOUR_REGS_PAC,        "PAC",          fourRegsFingerprintPAC },
+    { FOUR_REGS_PM,         "PM",           fourRegsFingerprintPM },
+    { FOUR_REGS_SUPC,       "SUPC",         fourRegsFingerprintSUPC },
+    { FOUR_REGS_WDT,        "WDT",          fourRegsFingerprintWDT },
+    { FOUR_REGS_AC,         "AC",           fourRegsFingerprintAC },
+    { FOUR_REGS_ADC,        "ADC",          fourRegsFingerprintADC },
+    { FOUR_REGS_AES,        "AES",          fourRegsFingerprintAES },
+#ifdef CAN0
+    { FOUR_REGS_CAN,        "CAN",          fourRegsFingerprintCAN },
+#endif
+    { FOUR_REGS_CCL,        "CCL",          fourRegsFingerprintCCL },
+    { FOUR_REGS_DAC,        "DAC",          fourRegsFingerprintDAC },
+    { FOUR_REGS_EIC,        "EIC",          fourRegsFingerprintEIC },
+    { FOUR_REGS_FREQM,      "FREQM",        fourRegsFingerprintFREQM },
+    { FOUR_REGS_HMATRIX,    "HMATRIX",      fourRegsFingerprintHMATRIX },
+#ifdef I2S
+    { FOUR_REGS_I2S,        "I2S",          fourRegsFingerprintI2S },
+#endif
+    { FOUR_REGS_ICM,        "ICM",          fourRegsFingerprintICM },
+    { FOUR_REGS_NVMCTRL,    "NVMCTRL",      fourRegsFingerprintNVMCTRL },
+    { FOUR_REGS_PCC,        "PCC",          fourRegsFingerprintPCC },
+    { FOUR_REGS_PDEC,       "PDEC",         fourRegsFingerprintPDEC },
+    { FOUR_REGS_PORT,       "PORT",         fourRegsFingerprintPORT },
+    { FOUR_REGS_QSPI,       "QSPI",         fourRegsFingerprintQSPI },
+#ifdef SDHC0
+    { FOUR_REGS_SDHC,       "SDHC",         fourRegsFingerprintSDHC },
+#endif
+    { FOUR_REGS_SERCOM,     "SERCOM",       fourRegsFingerprintSERCOM },
+    { FOUR_REGS_TCC,        "TCC",          fourRegsFingerprintTCC },
+    { FOUR_REGS_TC,         "TC",           fourRegsFingerprintTC },
+    { FOUR_REGS_TRNG,       "TRNG",         fourRegsFingerprintTRNG },
+    { FOUR_REGS_USB,        "USB",          fourRegsFingerprintUSB },
+};
+#define FourRegsFingerprint_COUNT (sizeof(FourRegsFingerprint_peripherals) / sizeof(FourRegsFingerprint_peripherals[0]))
+
+uint32_t fourRegsFingerprint(uint64_t peripherals) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint8_t i = 0; i < FourRegsFingerprint_COUNT; i++) {
+        if (peripherals & FourRegsFingerprint_peripherals[i].bit) {
+            crc = FourRegsFingerprint_peripherals[i].fingerprint(crc);
+        }
+    }
+    return ~crc;
+}
+
+void printFourRegsFingerprint(FourRegOptions &opts) {
+    opts.print.println("--------------------------- FINGERPRINT");
+    for (uint8_t i = 0; i < FourRegsFingerprint_COUNT; i++) {
+        opts.print.print(FourRegsFingerprint_peripherals[i].name);
+        opts.print.print(":  ");
+        PRINTHEX(fourRegsFingerprint(FourRegsFingerprint_peripherals[i].bit));
+        PRINTNL();
+    }
+    opts.print.print("ALL:  ");
+    PRINTHEX(fourRegsFingerprint(FOUR_REGS_ALL));
+    PRINTNL();
+}
+
+
+// Only reads registers (no waiting on SYNCBUSY), so it's safe to call from a
+// fault handler.
+void fourRegsSnapshotCapture(FourRegsSnapshot &snap) {
+    memset(&snap, 0, sizeof(snap));
+    snap.millis = millis();
+    snap.osculp32k = OSC32KCTRL->OSCULP32K.reg;
+    snap.xosc32k = OSC32KCTRL->XOSC32K.reg;
+    snap.rtcctrl = OSC32KCTRL->RTCCTRL.reg;
+    snap.cfdctrl = OSC32KCTRL->CFDCTRL.reg;
+    for (uint8_t id = 0; id < 2; id++) {
+        snap.xoscctrl[id] = OSCCTRL->XOSCCTRL[id].reg;
+        snap.dpllctrla[id] = OSCCTRL->Dpll[id].DPLLCTRLA.reg;
+        snap.dpllratio[id] = OSCCTRL->Dpll[id].DPLLRATIO.reg;
+        snap.dpllctrlb[id] = OSCCTRL->Dpll[id].DPLLCTRLB.reg;
+    }
+    snap.dfllctrla = OSCCTRL->DFLLCTRLA.reg;
+    snap.dfllctrlb = OSCCTRL->DFLLCTRLB.reg;
+    snap.dfllval = OSCCTRL->DFLLVAL.reg;
+    snap.dfllmul = OSCCTRL->DFLLMUL.reg;
+    for (uint8_t genid = 0; genid < 12; genid++) {
+        snap.genctrl[genid] = GCLK->GENCTRL[genid].reg;
+    }
+    for (uint8_t pchid = 0; pchid < 48; pchid++) {
+        snap.pchctrl[pchid] = GCLK->PCHCTRL[pchid].reg;
+    }
+    snap.cpudiv = MCLK->CPUDIV.reg;
+    snap.nvmctrla = NVMCTRL->CTRLA.reg;
+    snap.ahbmask = MCLK->AHBMASK.reg;
+    snap.apbmask[0] = MCLK->APBAMASK.reg;
+    snap.apbmask[1] = MCLK->APBBMASK.reg;
+    snap.apbmask[2] = MCLK->APBCMASK.reg;
+    snap.apbmask[3] = MCLK->APBDMASK.reg;
+    for (uint8_t gid = 0; gid < fourRegsPORTGroups(); gid++) {
+        PortGroup &group = PORT->Group[gid];
+        snap.dir[gid] = group.DIR.reg;
+        snap.out[gid] = group.OUT.reg;
+        for (uint8_t pid = 0; pid < 32; pid++) {
+            snap.pincfg[gid][pid] = group.PINCFG[pid].reg;
+        }
+        for (uint8_t n = 0; n < 16; n++) {
+            snap.pmux[gid][n] = group.PMUX[n].reg;
+        }
+    }
+    for (uint8_t idx = 0; idx < 8; idx++) {
+        Sercom* sercom = fourRegsSERCOM(idx);
+        if (!sercom) {
+            continue;
+        }
+        // the I2CM view has all four as 32-bit registers
+        snap.sercom[idx][0] = sercom->I2CM.CTRLA.reg;
+        snap.sercom[idx][1] = sercom->I2CM.CTRLB.reg;
+        snap.sercom[idx][2] = sercom->I2CM.CTRLC.reg;
+        snap.sercom[idx][3] = sercom->I2CM.BAUD.reg;
+    }
+}
+
+void printFourRegsSnapshot_BODY(FourRegOptions &opts, const FourRegsSnapshot &snap) {
+    opts.print.print("TIME:  ms=");
+    opts.print.print(snap.millis);
+    PRINTNL();
+
+    opts.print.print("OSC32KCTRL:  XOSC32K=");
+    PRINTHEX(snap.xosc32k);
+    opts.print.print(" OSCULP32K=");
+    PRINTHEX(snap.osculp32k);
+    opts.print.print(" RTCCTRL=");
+    PRINTHEX(snap.rtcctrl);
+    opts.print.print(" CFDCTRL=");
+    PRINTHEX(snap.cfdctrl);
+    PRINTNL();
+    for (uint8_t id = 0; id < 2; id++) {
+        OSCCTRL_XOSCCTRL_Type xosc;
+        xosc.reg = snap.xoscctrl[id];
+        if (!xosc.bit.ENABLE && !opts.showDisabled) {
+            continue;
+        }
+        opts.print.print("XOSC");
+        opts.print.print(id);
+        opts.print.print(":  ");
+        PRINTHEX(xosc.reg);
+        PRINTFLAG(xosc, ENABLE);
+        PRINTNL();
+    }
+    opts.print.print("DFLL:  CTRLA=");
+    PRINTHEX(snap.dfllctrla);
+    opts.print.print(" CTRLB=");
+    PRINTHEX(snap.dfllctrlb);
+    opts.print.print(" VAL=");
+    PRINTHEX(snap.dfllval);
+    opts.print.print(" MUL=");
+    PRINTHEX(snap.dfllmul);
+    PRINTNL();
+    for (uint8_t id = 0; id < 2; id++) {
+        OSCCTRL_DPLLCTRLA_Type ctrla;
+        OSCCTRL_DPLLRATIO_Type ratio;
+        OSCCTRL_DPLLCTRLB_Type ctrlb;
+        ctrla.reg = snap.dpllctrla[id];
+        ratio.reg = snap.dpllratio[id];
+        ctrlb.reg = snap.dpllctrlb[id];
+        if (!ctrla.bit.ENABLE && !opts.showDisabled) {
+            continue;
+        }
+        opts.print.print("DPLL");
+        opts.print.print(id);
+        opts.print.print(": ");
+        PRINTFLAG(ctrla, ENABLE);
+        opts.print.print(" refclk=");
+        PRINTHEX(ctrlb.bit.REFCLK);
+        opts.print.print(" ldr=");
+        opts.print.print(ratio.bit.LDR + ratio.bit.LDRFRAC / 32.0, 1);
+        opts.print.print(" DIV=");
+        opts.print.print(ctrlb.bit.DIV);
+        PRINTNL();
+    }
+
+    for (uint8_t genid = 0; genid < 12; genid++) {
+        GCLK_GENCTRL_Type gen;
+        gen.reg = snap.genctrl[genid];
+        if (!gen.bit.GENEN) {
+            continue;
+        }
+        PRINTRAW(gen.reg);
+        opts.print.print("GEN");
+        PRINTPAD2(genid);
+        opts.print.print(":  ");
+        opts.print.print("src=");
+        opts.print.print(FourRegsGCLK_SRCs[gen.bit.SRC]);
+        opts.print.print(" div=");
+        if (gen.bit.DIVSEL) {
+            PRINTSCALE(gen.bit.DIV + 1);
+        } else {
+            opts.print.print(gen.bit.DIV > 1 ? gen.bit.DIV : 1);
+        }
+        PRINTFLAG(gen, IDC);
+        PRINTFLAG(gen, OE);
+        PRINTFLAG(gen, RUNSTDBY);
+        PRINTNL();
+    }
+    for (uint8_t pchid = 0; pchid < 48; pchid++) {
+        GCLK_PCHCTRL_Type pch;
+        pch.reg = snap.pchctrl[pchid];
+        if (!pch.bit.CHEN) {
+            continue;
+        }
+        PRINTRAW(pch.reg);
+        opts.print.print("GCLK_");
+        opts.print.print(FourRegsGCLK_CHANs[pchid]);
+        opts.print.print(":  gen=GEN");
+        PRINTPAD2(pch.bit.GEN);
+        PRINTFLAG(pch, WRTLOCK);
+        PRINTNL();
+    }
+
+    opts.print.print("MCLK:  CPUDIV=/");
+    opts.print.print(snap.cpudiv);
+    opts.print.print(" AHBMASK=");
+    PRINTHEX(snap.ahbmask);
+    for (uint8_t n = 0; n < 4; n++) {
+        opts.print.print(" APB");
+        opts.print.print((char) ('A' + n));
+        opts.print.print("MASK=");
+        PRINTHEX(snap.apbmask[n]);
+    }
+    PRINTNL();
+    NVMCTRL_CTRLA_Type nvm;
+    nvm.reg = snap.nvmctrla;
+    opts.print.print("NVMCTRL:  RWS=");
+    opts.print.print(nvm.bit.RWS);
+    PRINTFLAG(nvm, AUTOWS);
+    PRINTNL();
+
+    for (uint8_t gid = 0; gid < fourRegsPORTGroups(); gid++) {
+        for (uint8_t pid = 0; pid < 32; pid++) {
+            PORT_PINCFG_Type cfg;
+            cfg.reg = snap.pincfg[gid][pid];
+            bool output = snap.dir[gid] & (1UL << pid);
+            if (!cfg.reg && !output) {
+                continue;
+            }
+            opts.print.print("P");
+            opts.print.print((char) ('A' + gid));
+            PRINTPAD2(pid);
+            opts.print.print(": ");
+            if (cfg.bit.PMUXEN) {
+                uint8_t pmux = snap.pmux[gid][pid / 2];
+                pmux = (pid & 1) ? (pmux >> 4) : (pmux & 0xF);
+                opts.print.print(" pmux=");
+                opts.print.print((char) ('A' + pmux));
+            }
+            opts.print.print(output ? " dir=output" : " dir=input");
+            if (snap.out[gid] & (1UL << pid)) {
+                opts.print.print(" OUT");
+            }
+            PRINTFLAG(cfg, INEN);
+            PRINTFLAG(cfg, PULLEN);
+            PRINTFLAG(cfg, DRVSTR);
+            PRINTNL();
+        }
+    }
+
+    for (uint8_t idx = 0; idx < 8; idx++) {
+        SERCOM_I2CM_CTRLA_Type ctrla;
+        ctrla.reg = snap.sercom[idx][0];
+        if (!ctrla.bit.ENABLE && !opts.showDisabled) {
+            continue;
+        }
+        opts.print.print("SERCOM");
+        opts.print.print(idx);
+        opts.print.print(": ");
+        PRINTFLAG(ctrla, ENABLE);
+        opts.print.print(" mode=");
+        switch (ctrla.bit.MODE) {
+            case 0x0: opts.print.print("USART_EXT"); break;
+            case 0x1: opts.print.print("USART"); break;
+            case 0x2: opts.print.print("SPI_SLAVE"); break;
+            case 0x3: opts.print.print("SPI_MASTER"); break;
+            case 0x4: opts.print.print("I2C_SLAVE"); break;
+            case 0x5: opts.print.print("I2C_MASTER"); break;
+            default:  opts.print.print(FourRegs__RESERVED); break;
+        }
+        opts.print.print(" CTRLA=");
+        PRINTHEX(snap.sercom[idx][0]);
+        opts.print.print(" CTRLB=");
+        PRINTHEX(snap.sercom[idx][1]);
+        opts.print.print(" CTRLC=");
+        PRINTHEX(snap.sercom[idx][2]);
+        opts.print.print(" BAUD=");
+        PRINTHEX(snap.sercom[idx][3]);
+        PRINTNL();
+    }
+}
+
+void printFourRegsSnapshot(FourRegOptions &opts, const FourRegsSnapshot &snap) {
+    opts.print.println("--------------------------- SNAPSHOT");
+    printFourRegsSnapshot_BODY(opts, snap);
+}
+
+
+// The crash record goes in backup RAM just after the reset history, so both
+// survive the reset which follows the fault.
+#ifndef FOUR_REGS_CRASH_ADDR
+#define FOUR_REGS_CRASH_ADDR (FOUR_REGS_HISTORY_ADDR + sizeof(FourRegsHistory))
+#endif
+#define FourRegsCRASH_MAGIC 0x43524634      // "4FRC"
+#define FourRegsCRASH_VERSION 1
+
+struct FourRegsCrash {
+    uint32_t magic;
+    uint8_t  version;
+    uint8_t  exception;     // 3=HardFault 4=MemManage 5=BusFault 6=UsageFault
+    uint16_t reserved;
+    uint32_t excreturn;     // LR on entry to the handler
+    uint32_t sp;            // where the exception frame was stacked
+    uint32_t frame[8];      // stacked r0 r1 r2 r3 r12 lr pc xpsr
+    uint32_t cfsr;
+    uint32_t hfsr;
+    uint32_t mmfar;
+    uint32_t bfar;
+    FourRegsSnapshot snapshot;
+    uint32_t crc;           // of everything above
+};
+#define FourRegsCRASH ((FourRegsCrash*) (FOUR_REGS_CRASH_ADDR))
+
+uint32_t fourRegsCrashCRC(const FourRegsCrash* crash) {
+    uint32_t crc = 0xFFFFFFFF;
+    const uint32_t* words = (const uint32_t*) crash;
+    for (uint16_t n = 0; n < offsetof(FourRegsCrash, crc) / 4; n++) {
+        crc = fourRegsCRC32(crc, words[n]);
+    }
+    return ~crc;
+}
+
+// Called by fourRegsCrashHandler() with the stack pointer at the time of the
+// fault.  This runs in the fault context, so it mustn't print, allocate, or
+// wait on anything.
+extern "C" __attribute__((used)) void fourRegsCrashRecord(uint32_t* sp, uint32_t excreturn) {
+    FourRegsCrash* crash = FourRegsCRASH;
+    crash->magic = FourRegsCRASH_MAGIC;
+    crash->version = FourRegsCRASH_VERSION;
+    crash->exception = __get_IPSR() & 0x1FF;
+    crash->reserved = 0;
+    crash->excreturn = excreturn;
+    crash->sp = (uint32_t) sp;
+    // a stack overflow can leave the stack pointer outside of RAM, and
+    // reading it would fault again
+    bool valid = (uint32_t) sp >= HSRAM_ADDR && (uint32_t) (sp + 8) <= HSRAM_ADDR + HSRAM_SIZE;
+    for (uint8_t n = 0; n < 8; n++) {
+        crash->frame[n] = valid ? sp[n] : 0;
+    }
+    crash->cfsr = SCB->CFSR;
+    crash->hfsr = SCB->HFSR;
+    crash->mmfar = SCB->MMFAR;
+    crash->bfar = SCB->BFAR;
+    fourRegsSnapshotCapture(crash->snapshot);
+    crash->crc = fourRegsCrashCRC(crash);
+    __DSB();
+    NVIC_SystemReset();
+}
+
+// Stack which fourRegsCrashRecord() runs on.  The stack at the time of the
+// fault might be the problem (MSTKERR/STKERR after an overflow), and pushing
+// onto it again would fault again and lock up the core.
+#define FourRegsCRASH_STACK 128     // words
+#define FourRegsCRASH_STR(x) #x
+#define FourRegsCRASH_XSTR(x) FourRegsCRASH_STR(x)
+extern "C" {
+    __attribute__((used, aligned(8))) uint32_t fourRegsCrashStack[FourRegsCRASH_STACK];
+}
+
+// Finds which stack the exception frame was pushed on, switches to
+// fourRegsCrashStack, then hands over to fourRegsCrashRecord().  Naked so that
+// the compiler doesn't touch the stack first.
+extern "C" __attribute__((naked)) void fourRegsCrashHandler() {
+    __asm volatile(
+        "tst lr, #4         \n"
+        "ite eq             \n"
+        "mrseq r0, msp      \n"
+        "mrsne r0, psp      \n"
+        "mov r1, lr         \n"
+        "movw r2, #:lower16:fourRegsCrashStack+4*" FourRegsCRASH_XSTR(FourRegsCRASH_STACK) " \n"
+        "movt r2, #:upper16:fourRegsCrashStack+4*" FourRegsCRASH_XSTR(FourRegsCRASH_STACK) " \n"
+        "msr msp, r2        \n"
+        "b fourRegsCrashRecord \n"
+    );
+}
+
+void fourRegsCrashHookInstall() {
+    fourRegsVectorsToSRAM();
+    __disable_irq();
+    FourRegsVECTORs[3] = fourRegsCrashHandler;      // HardFault
+    FourRegsVECTORs[4] = fourRegsCrashHandler;      // MemManage
+    FourRegsVECTORs[5] = fourRegsCrashHandler;      // BusFault
+    FourRegsVECTORs[6] = fourRegsCrashHandler;      // UsageFault
+    __DSB();
+    __enable_irq();
+}
+
+void fourRegsCrashClear() {
+    FourRegsCRASH->magic = 0;
+}
+
+// [B3.2.15 ARMv7-M ARM] Configurable Fault Status Register
+static const char* const FourRegsCRASH_CFSRs[32] = {
+    "IACCVIOL", "DACCVIOL", NULL, "MUNSTKERR", "MSTKERR", "MLSPERR", NULL, "MMARVALID",
+    "IBUSERR", "PRECISERR", "IMPRECISERR", "UNSTKERR", "STKERR", "LSPERR", NULL, "BFARVALID",
+    "UNDEFINSTR", "INVSTATE", "INVPC", "NOCP", NULL, NULL, NULL, NULL,
+    "UNALIGNED", "DIVBYZERO", NULL, NULL, NULL, NULL, NULL, NULL,
+};
+
+void printFourRegsCrash(FourRegOptions &opts) {
+    const FourRegsCrash* crash = FourRegsCRASH;
+    bool valid = crash->magic == FourRegsCRASH_MAGIC && crash->version == FourRegsCRASH_VERSION
+        && crash->crc == fourRegsCrashCRC(crash);
+    if (!valid && !opts.showDisabled) {
+        return;
+    }
+    opts.print.println("--------------------------- CRASH");
+    if (!valid) {
+        opts.print.println(FourRegs__DISABLED);
+        return;
+    }
+    opts.print.print("FAULT:  exception=");
+    switch (crash->exception) {
+        case 3: opts.print.print("HardFault"); break;
+        case 4: opts.print.print("MemManage"); break;
+        case 5: opts.print.print("BusFault"); break;
+        case 6: opts.print.print("UsageFault"); break;
+        default: opts.print.print(crash->exception); break;
+    }
+    opts.print.print(" EXC_RETURN=");
+    PRINTHEX(crash->excreturn);
+    opts.print.print(" sp=");
+    PRINTHEX(crash->sp);
+    PRINTNL();
+
+    static const char* const names[8] = { "r0", "r1", "r2", "r3", "r12", "lr", "pc", "xpsr" };
+    opts.print.print("FRAME: ");
+    for (uint8_t n = 0; n < 8; n++) {
+        opts.print.print(" ");
+        opts.print.print(names[n]);
+        opts.print.print("=");
+        PRINTHEX(crash->frame[n]);
+    }
+    PRINTNL();
+
+    opts.print.print("CFSR: ");
+    for (uint8_t bit = 0; bit < 32; bit++) {
+        if ((crash->cfsr & (1UL << bit)) && FourRegsCRASH_CFSRs[bit]) {
+            opts.print.print(" ");
+            opts.print.print(FourRegsCRASH_CFSRs[bit]);
+        }
+    }
+    PRINTNL();
+    opts.print.print("HFSR: ");
+    if (READSCS(crash->hfsr, SCB_HFSR_VECTTBL)) {
+        opts.print.print(" VECTTBL");
+    }
+    if (READSCS(crash->hfsr, SCB_HFSR_FORCED)) {
+        opts.print.print(" FORCED");
+    }
+    if (READSCS(crash->hfsr, SCB_HFSR_DEBUGEVT)) {
+        opts.print.print(" DEBUGEVT");
+    }
+    PRINTNL();
+    if (crash->cfsr & (1UL << 7)) {
+        opts.print.print("MMFAR:  ");
+        PRINTHEX(crash->mmfar);
+        PRINTNL();
+    }
+    if (crash->cfsr & (1UL << 15)) {
+        opts.print.print("BFAR:  ");
+        PRINTHEX(crash->bfar);
+        PRINTNL();
+    }
+    printFourRegsSnapshot(opts, crash->snapshot);
+}
+
+
+// The snapshot log is a ring of entries in the SmartEEPROM, which does its
+// own wear leveling.  FOUR_REGS_SEE_OFFSET can move the start of the ring if
+// the sketch uses the start of the SmartEEPROM for something else.
+#ifndef FOUR_REGS_SEE_OFFSET
+#define FOUR_REGS_SEE_OFFSET 0
+#endif
+#define FourRegsSEE_MAGIC 0x4C524634        // "4FRL"
+#define FourRegsSEE_TIMEOUT 1000000         // polls of SEESTAT.BUSY
+
+struct FourRegsSEE_Entry {
+    uint32_t magic;
+    uint32_t sequence;      // counts up from 1, the highest is the newest
+    FourRegsSnapshot snapshot;
+    uint32_t crc;           // of everything above
+};
+#define FourRegsSEE_ENTRIES ((volatile FourRegsSEE_Entry*) (SEEPROM_ADDR + FOUR_REGS_SEE_OFFSET))
+
+// number of entries which fit, or 0 if the SmartEEPROM isn't set up
+uint16_t fourRegsSEE_slots() {
+    if (!NVMCTRL->SEESTAT.bit.SBLK) {
+        return 0;
+    }
+    // datasheet "SmartEEPROM Virtual Size in Bytes" table: the virtual size is
+    // 512 << PSZ, but at most what SBLK physical blocks can hold
+    uint8_t sblk = NVMCTRL->SEESTAT.bit.SBLK;
+    uint32_t bytes = 512UL << NVMCTRL->SEESTAT.bit.PSZ;
+    uint32_t most;
+    if (sblk == 1) {
+        most = 4096;
+    } else if (sblk == 2) {
+        most = 8192;
+    } else if (sblk <= 4) {
+        most = 16384;
+    } else if (sblk <= 8) {
+        most = 32768;
+    } else {
+        most = 65536;
+    }
+    if (bytes > most) {
+        bytes = most;
+    }
+    if (bytes <= FOUR_REGS_SEE_OFFSET) {
+        return 0;
+    }
+    return (bytes - FOUR_REGS_SEE_OFFSET) / sizeof(FourRegsSEE_Entry);
+}
+
+bool fourRegsSEE_wait() {
+    for (uint32_t n = 0; n < FourRegsSEE_TIMEOUT; n++) {
+        if (!NVMCTRL->SEESTAT.bit.BUSY) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t fourRegsSEE_crc(volatile FourRegsSEE_Entry* entry) {
+    uint32_t crc = 0xFFFFFFFF;
+    volatile uint32_t* words = (volatile uint32_t*) entry;
+    for (uint16_t n = 0; n < offsetof(FourRegsSEE_Entry, crc) / 4; n++) {
+        crc = fourRegsCRC32(crc, words[n]);
+    }
+    return ~crc;
+}
+
+// returns the sequence number of the entry in the slot, or 0 if it isn't valid
+uint32_t fourRegsSEE_sequence(uint16_t slot) {
+    volatile FourRegsSEE_Entry* entry = &FourRegsSEE_ENTRIES[slot];
+    if (entry->magic != FourRegsSEE_MAGIC || entry->crc != fourRegsSEE_crc(entry)) {
+        return 0;
+    }
+    return entry->sequence;
+}
+
+// finds the slot with the newest entry, and returns its sequence number (0 if the log is empty)
+uint32_t fourRegsSEE_newest(uint16_t slots, uint16_t &newest) {
+    uint32_t sequence = 0;
+    newest = 0;
+    for (uint16_t slot = 0; slot < slots; slot++) {
+        uint32_t seq = fourRegsSEE_sequence(slot);
+        if (seq > sequence) {
+            sequence = seq;
+            newest = slot;
+        }
+    }
+    return sequence;
+}
+
+bool fourRegsSnapshotLogAppend(const FourRegsSnapshot &snap) {
+    uint16_t slots = fourRegsSEE_slots();
+    if (!slots || NVMCTRL->SEESTAT.bit.LOCK || NVMCTRL->SEESTAT.bit.RLOCK) {
+        return false;
+    }
+    if (!fourRegsSEE_wait()) {
+        return false;
+    }
+    uint16_t slot;
+    uint32_t sequence = fourRegsSEE_newest(slots, slot);
+    slot = sequence ? (slot + 1) % slots : 0;
+
+    FourRegsSEE_Entry entry;
+    entry.magic = FourRegsSEE_MAGIC;
+    entry.sequence = sequence + 1;
+    entry.snapshot = snap;
+    entry.crc = 0;
+    entry.crc = fourRegsSEE_crc(&entry);
+
+    // The SmartEEPROM takes 32-bit writes, but each one has to finish
+    // before the next one starts.
+    const uint32_t* src = (const uint32_t*) &entry;
+    volatile uint32_t* dst = (volatile uint32_t*) &FourRegsSEE_ENTRIES[slot];
+    for (uint16_t n = 0; n < sizeof(entry) / 4; n++) {
+        if (!fourRegsSEE_wait()) {
+            return false;
+        }
+        dst[n] = src[n];
+    }
+    if (NVMCTRL->SEECFG.bit.WMODE) {
+        // buffered mode only writes the page to flash when it's full
+        if (!fourRegsSEE_wait()) {
+            return false;
+        }
+        NVMCTRL->CTRLB.reg = NVMCTRL_CTRLB_CMDEX_KEY | NVMCTRL_CTRLB_CMD_SEEFLUSH;
+    }
+    return fourRegsSEE_wait();
+}
+
+uint16_t fourRegsSnapshotLogCount() {
+    uint16_t slots = fourRegsSEE_slots();
+    uint16_t count = 0;
+    for (uint16_t slot = 0; slot < slots; slot++) {
+        if (fourRegsSEE_sequence(slot)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool fourRegsSnapshotLogRead(uint16_t age, FourRegsSnapshot &snap, uint32_t* sequence) {
+    uint16_t slots = fourRegsSEE_slots();
+    if (age >= slots || !fourRegsSEE_wait()) {
+        return false;
+    }
+    uint16_t newest;
+    uint32_t seq = fourRegsSEE_newest(slots, newest);
+    if (seq <= age) {
+        return false;
+    }
+    uint16_t slot = (newest + slots - age) % slots;
+    // a sequence gap means the older entry was lost, such as to a power cut mid-write
+    if (fourRegsSEE_sequence(slot) != seq - age) {
+        return false;
+    }
+    COPYVOL(snap, FourRegsSEE_ENTRIES[slot].snapshot);
+    if (sequence) {
+        *sequence = seq - age;
+    }
+    return true;
+}
+
+void printFourRegsSnapshotLog(FourRegOptions &opts) {
+    opts.print.println("--------------------------- SNAPSHOT LOG");
+    uint16_t slots = fourRegsSEE_slots();
+    if (!slots) {
+        opts.print.println(FourRegs__DISABLED);
+        return;
+    }
+    uint16_t count = fourRegsSnapshotLogCount();
+    opts.print.print("LOG:  addr=");
+    PRINTHEX((uint32_t) FourRegsSEE_ENTRIES);
+    opts.print.print(" slots=");
+    opts.print.print(slots);
+    opts.print.print(" count=");
+    opts.print.print(count);
+    PRINTNL();
+    if (!fourRegsSEE_wait()) {
+        return;
+    }
+    // Find the newest entry once, then walk back from it while the sequence
+    // numbers run on unbroken (a gap is an entry lost mid-write).
+    uint16_t newest;
+    uint32_t seq = fourRegsSEE_newest(slots, newest);
+    uint16_t ages = 0;
+    while (ages < slots && ages < seq &&
+           fourRegsSEE_sequence((newest + slots - ages) % slots) == seq - ages) {
+        ages++;
+    }
+    // oldest first
+    for (uint16_t age = ages; age > 0; age--) {
+        uint16_t slot = (newest + slots - (age - 1)) % slots;
+        FourRegsSnapshot snap;
+        COPYVOL(snap, FourRegsSEE_ENTRIES[slot].snapshot);
+        opts.print.print("--------------------------- SNAPSHOT sequence=");
+        opts.print.print(seq - (age - 1));
+        PRINTNL();
+        printFourRegsSnapshot_BODY(opts, snap);
+    }
+}
+
+
+// Restoring a snapshot.  Every wait gives up after FourRegsAPPLY_TIMEOUT
+// polls, so a crystal or reference which is missing can't hang the board.
+// While the CPU runs from the 32k oscillator each poll is thousands of times
+// slower, so those waits get FourRegsAPPLY_TIMEOUT_32K polls instead (a few
+// seconds at 32 kHz, and still a couple of milliseconds at full speed).
+#define FourRegsAPPLY_TIMEOUT 1000000
+#define FourRegsAPPLY_TIMEOUT_32K 10000
+#define WAITFORN(cond,polls) do { uint32_t n = (polls); while (!(cond)) { if (!--n) { return false; } } } while(0)
+#define WAITFOR(cond) WAITFORN(cond, FourRegsAPPLY_TIMEOUT)
+
+// peripherals written by fourRegsSnapshotApply(), unlocked in the PAC while it runs
+static const uint8_t FourRegsAPPLY_PERIDs[] = {
+    ID_OSCCTRL, ID_OSC32KCTRL, ID_GCLK, ID_MCLK, ID_NVMCTRL, ID_PORT,
+    ID_SERCOM0, ID_SERCOM1, ID_SERCOM2, ID_SERCOM3, ID_SERCOM4, ID_SERCOM5,
+#ifdef SERCOM6
+    ID_SERCOM6,
+#endif
+#ifdef SERCOM7
+    ID_SERCOM7,
+#endif
+};
+#define FourRegsAPPLY_PERID_COUNT (sizeof(FourRegsAPPLY_PERIDs) / sizeof(FourRegsAPPLY_PERIDs[0]))
+
+// which stage of fourRegsSnapshotApply() a generator is restored in
+enum {
+    FourRegsAPPLY_OTHER,    // sources which are already running
+    FourRegsAPPLY_DFLL,
+    FourRegsAPPLY_DPLL,
+};
+
+uint8_t fourRegsSnapshotApply_stage(uint32_t genctrl) {
+    GCLK_GENCTRL_Type gen;
+    gen.reg = genctrl;
+    switch (gen.bit.SRC) {
+        case GCLK_GENCTRL_SRC_DFLL_Val:  return FourRegsAPPLY_DFLL;
+        case GCLK_GENCTRL_SRC_DPLL0_Val: return FourRegsAPPLY_DPLL;
+        case GCLK_GENCTRL_SRC_DPLL1_Val: return FourRegsAPPLY_DPLL;
+    }
+    return FourRegsAPPLY_OTHER;
+}
+
+// how many polls the waits get, depending on what the CPU runs from
+uint32_t fourRegsSnapshotApply_polls() {
+    if (GCLK->GENCTRL[0].bit.SRC == GCLK_GENCTRL_SRC_OSCULP32K_Val) {
+        return FourRegsAPPLY_TIMEOUT_32K;
+    }
+    return FourRegsAPPLY_TIMEOUT;
+}
+
+bool fourRegsSnapshotApply_GEN(uint8_t genid, uint32_t genctrl, uint32_t polls) {
+    WAITFORN(!GCLK->SYNCBUSY.reg, polls);
+    GCLK->GENCTRL[genid].reg = genctrl;
+    WAITFORN(!GCLK->SYNCBUSY.reg, polls);
+    return true;
+}
+
+// generators 1 through 11 whose source is restored in the stage
+bool fourRegsSnapshotApply_GENS(const FourRegsSnapshot &snap, uint8_t stage, uint32_t polls) {
+    for (uint8_t genid = 1; genid < 12; genid++) {
+        if (fourRegsSnapshotApply_stage(snap.genctrl[genid]) != stage) {
+            continue;
+        }
+        if (!fourRegsSnapshotApply_GEN(genid, snap.genctrl[genid], polls)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool fourRegsSnapshotApply_PCH(const FourRegsSnapshot &snap, uint8_t pchid) {
+    GCLK_PCHCTRL_Type pch;
+    pch.reg = snap.pchctrl[pchid];
+    if (GCLK->PCHCTRL[pchid].bit.WRTLOCK || GCLK->PCHCTRL[pchid].reg == pch.reg) {
+        return true;
+    }
+    // the generator can only be changed while the channel is off
+    GCLK->PCHCTRL[pchid].reg = 0;
+    WAITFOR(!GCLK->PCHCTRL[pchid].bit.CHEN);
+    GCLK->PCHCTRL[pchid].reg = pch.reg;
+    if (pch.bit.CHEN) {
+        WAITFOR(GCLK->PCHCTRL[pchid].bit.CHEN);
+    }
+    return true;
+}
+
+bool fourRegsSnapshotApply_DFLL(const FourRegsSnapshot &snap) {
+    if (OSCCTRL->DFLLCTRLA.reg == snap.dfllctrla && OSCCTRL->DFLLCTRLB.reg == snap.dfllctrlb
+            && OSCCTRL->DFLLMUL.reg == snap.dfllmul) {
+        return true;
+    }
+    // The CPU can't run from the DFLL while it's off, so GEN0 waits on the
+    // ultra low power oscillator (as the Arduino core's startup does).
+    if (!fourRegsSnapshotApply_GEN(0, GCLK_GENCTRL_SRC(GCLK_GENCTRL_SRC_OSCULP32K_Val) | GCLK_GENCTRL_GENEN,
+            FourRegsAPPLY_TIMEOUT_32K)) {
+        return false;
+    }
+    OSCCTRL->DFLLCTRLA.reg = 0;
+    WAITFORN(!OSCCTRL->DFLLSYNC.bit.ENABLE, FourRegsAPPLY_TIMEOUT_32K);
+    OSCCTRL->DFLLMUL.reg = snap.dfllmul;
+    WAITFORN(!OSCCTRL->DFLLSYNC.bit.DFLLMUL, FourRegsAPPLY_TIMEOUT_32K);
+    OSCCTRL->DFLLVAL.reg = snap.dfllval;
+    WAITFORN(!OSCCTRL->DFLLSYNC.bit.DFLLVAL, FourRegsAPPLY_TIMEOUT_32K);
+    OSCCTRL->DFLLCTRLB.reg = snap.dfllctrlb;
+    WAITFORN(!OSCCTRL->DFLLSYNC.bit.DFLLCTRLB, FourRegsAPPLY_TIMEOUT_32K);
+    OSCCTRL->DFLLCTRLA.reg = snap.dfllctrla;
+    WAITFORN(!OSCCTRL->DFLLSYNC.bit.ENABLE, FourRegsAPPLY_TIMEOUT_32K);
+    if (OSCCTRL->DFLLCTRLA.bit.ENABLE) {
+        WAITFORN(OSCCTRL->STATUS.bit.DFLLRDY, FourRegsAPPLY_TIMEOUT_32K);
+    }
+    return true;
+}
+
+bool fourRegsSnapshotApply_DPLL(const FourRegsSnapshot &snap, uint8_t id, uint32_t polls) {
+    OscctrlDpll &dpll = OSCCTRL->Dpll[id];
+    if (dpll.DPLLCTRLA.reg == snap.dpllctrla[id] && dpll.DPLLRATIO.reg == snap.dpllratio[id]
+            && dpll.DPLLCTRLB.reg == snap.dpllctrlb[id]) {
+        return true;
+    }
+    dpll.DPLLCTRLA.reg = 0;
+    WAITFORN(!dpll.DPLLSYNCBUSY.bit.ENABLE, polls);
+    dpll.DPLLCTRLB.reg = snap.dpllctrlb[id];
+    dpll.DPLLRATIO.reg = snap.dpllratio[id];
+    WAITFORN(!dpll.DPLLSYNCBUSY.bit.DPLLRATIO, polls);
+    dpll.DPLLCTRLA.reg = snap.dpllctrla[id];
+    WAITFORN(!dpll.DPLLSYNCBUSY.bit.ENABLE, polls);
+    if (dpll.DPLLCTRLA.bit.ENABLE) {
+        WAITFORN(dpll.DPLLSTATUS.bit.LOCK && dpll.DPLLSTATUS.bit.CLKRDY, polls);
+    }
+    return true;
+}
+
+bool fourRegsSnapshotApply_SERCOM(const FourRegsSnapshot &snap, uint8_t idx) {
+    Sercom* sercom = fourRegsSERCOM(idx);
+    if (!sercom) {
+        return true;
+    }
+    SercomI2cm &regs = sercom->I2CM;
+    if (regs.CTRLA.reg == snap.sercom[idx][0] && regs.CTRLB.reg == snap.sercom[idx][1]
+            && regs.CTRLC.reg == snap.sercom[idx][2] && regs.BAUD.reg == snap.sercom[idx][3]) {
+        return true;
+    }
+    // everything but CTRLA is enable-protected, and its layout depends on the mode in CTRLA
+    regs.CTRLA.bit.ENABLE = 0;
+    WAITFOR(!regs.SYNCBUSY.bit.ENABLE);
+    regs.CTRLA.reg = snap.sercom[idx][0] & ~SERCOM_I2CM_CTRLA_ENABLE;
+    regs.CTRLB.reg = snap.sercom[idx][1];
+    regs.CTRLC.reg = snap.sercom[idx][2];
+    regs.BAUD.reg = snap.sercom[idx][3];
+    WAITFOR(!regs.SYNCBUSY.reg);
+    if (snap.sercom[idx][0] & SERCOM_I2CM_CTRLA_ENABLE) {
+        regs.CTRLA.bit.ENABLE = 1;
+        WAITFOR(!regs.SYNCBUSY.bit.ENABLE);
+    }
+    return true;
+}
+
+// `clocked` is set once GEN0 and the flash wait states have their final
+// values, after which a failure leaves the CPU clock alone.
+bool fourRegsSnapshotApply_STEPS(const FourRegsSnapshot &snap, bool &clocked) {
+    // Until GEN0 is back at its final speed, the flash runs with the most
+    // wait states so that any speed in between is safe.
+    NVMCTRL->CTRLA.reg = (NVMCTRL->CTRLA.reg & ~NVMCTRL_CTRLA_AUTOWS) | NVMCTRL_CTRLA_RWS(0xF);
+
+    // The CPU runs from the DFLL while the oscillators and DPLLs are changed,
+    // so it can't lose its clock when one which feeds GEN0 is rewritten.  The
+    // DFLL is enabled out of reset, so it's only missing if the sketch turned
+    // it off.
+    if (!OSCCTRL->DFLLCTRLA.bit.ENABLE) {
+        OSCCTRL->DFLLCTRLA.bit.ENABLE = 1;
+        WAITFOR(!OSCCTRL->DFLLSYNC.bit.ENABLE);
+        WAITFOR(OSCCTRL->STATUS.bit.DFLLRDY);
+    }
+    if (!fourRegsSnapshotApply_GEN(0, GCLK_GENCTRL_SRC(GCLK_GENCTRL_SRC_DFLL_Val) | GCLK_GENCTRL_GENEN,
+            fourRegsSnapshotApply_polls())) {
+        return false;
+    }
+
+    // 32k oscillators
+    OSC32KCTRL->OSCULP32K.reg = snap.osculp32k;
+    if (OSC32KCTRL->XOSC32K.reg != snap.xosc32k) {
+        // the configuration can only be changed while the oscillator is off
+        OSC32KCTRL->XOSC32K.bit.ENABLE = 0;
+        OSC32KCTRL->XOSC32K.reg = snap.xosc32k;
+        if (OSC32KCTRL->XOSC32K.bit.ENABLE) {
+            WAITFOR(OSC32KCTRL->STATUS.bit.XOSC32KRDY);
+        }
+    }
+    OSC32KCTRL->RTCCTRL.reg = snap.rtcctrl;
+    OSC32KCTRL->CFDCTRL.reg = snap.cfdctrl;
+
+    // crystal oscillators
+    for (uint8_t id = 0; id < 2; id++) {
+        if (OSCCTRL->XOSCCTRL[id].reg == snap.xoscctrl[id]) {
+            continue;
+        }
+        OSCCTRL->XOSCCTRL[id].bit.ENABLE = 0;
+        OSCCTRL->XOSCCTRL[id].reg = snap.xoscctrl[id];
+        if (OSCCTRL->XOSCCTRL[id].bit.ENABLE) {
+            WAITFOR(OSCCTRL->STATUS.reg & (OSCCTRL_STATUS_XOSCRDY0 << id));
+        }
+    }
+
+    // generators from the 32k and crystal oscillators, then the references
+    // of the DFLL and DPLLs which they feed
+    if (!fourRegsSnapshotApply_GENS(snap, FourRegsAPPLY_OTHER, FourRegsAPPLY_TIMEOUT)) {
+        return false;
+    }
+    for (uint8_t pchid = 0; pchid < 3; pchid++) {
+        if (!fourRegsSnapshotApply_PCH(snap, pchid)) {
+            return false;
+        }
+    }
+
+    if (!fourRegsSnapshotApply_DFLL(snap)) {
+        return false;
+    }
+    // if the snapshot has the DFLL off, GEN0 stays on the 32k oscillator
+    // until its final source is ready
+    if (OSCCTRL->DFLLCTRLA.bit.ENABLE) {
+        if (!fourRegsSnapshotApply_GEN(0, GCLK_GENCTRL_SRC(GCLK_GENCTRL_SRC_DFLL_Val) | GCLK_GENCTRL_GENEN,
+                fourRegsSnapshotApply_polls())) {
+            return false;
+        }
+    }
+    uint32_t polls = fourRegsSnapshotApply_polls();
+    if (!fourRegsSnapshotApply_GENS(snap, FourRegsAPPLY_DFLL, polls)) {
+        return false;
+    }
+
+    for (uint8_t id = 0; id < 2; id++) {
+        if (!fourRegsSnapshotApply_DPLL(snap, id, polls)) {
+            return false;
+        }
+    }
+    if (!fourRegsSnapshotApply_GENS(snap, FourRegsAPPLY_DPLL, polls)) {
+        return false;
+    }
+
+    // the CPU clock last
+    if (MCLK->CPUDIV.reg != snap.cpudiv) {
+        MCLK->INTFLAG.reg = MCLK_INTFLAG_CKRDY;
+        MCLK->CPUDIV.reg = snap.cpudiv;
+        WAITFORN(MCLK->INTFLAG.bit.CKRDY, polls);
+    }
+    if (!fourRegsSnapshotApply_GEN(0, snap.genctrl[0], polls)) {
+        return false;
+    }
+    NVMCTRL->CTRLA.reg = snap.nvmctrla;
+    clocked = true;
+
+    for (uint8_t pchid = 3; pchid < 48; pchid++) {
+        if (!fourRegsSnapshotApply_PCH(snap, pchid)) {
+            return false;
+        }
+    }
+
+    MCLK->AHBMASK.reg = snap.ahbmask;
+    MCLK->APBAMASK.reg = snap.apbmask[0];
+    MCLK->APBBMASK.reg = snap.apbmask[1];
+    MCLK->APBCMASK.reg = snap.apbmask[2];
+    MCLK->APBDMASK.reg = snap.apbmask[3];
+
+    // pins are muxed before they're driven
+    for (uint8_t gid = 0; gid < fourRegsPORTGroups(); gid++) {
+        PortGroup &group = PORT->Group[gid];
+        for (uint8_t n = 0; n < 16; n++) {
+            group.PMUX[n].reg = snap.pmux[gid][n];
+        }
+        for (uint8_t pid = 0; pid < 32; pid++) {
+            group.PINCFG[pid].reg = snap.pincfg[gid][pid];
+        }
+        group.OUT.reg = snap.out[gid];
+        group.DIR.reg = snap.dir[gid];
+    }
+
+    for (uint8_t idx = 0; idx < 8; idx++) {
+        if (!fourRegsSnapshotApply_SERCOM(snap, idx)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// After a timeout before GEN0 has its final source, the CPU might be left on
+// the 32k oscillator, or on a source which is being changed, with the most
+// flash wait states.  Put it back on the DFLL if that's running, otherwise on
+// what it started with.
+void fourRegsSnapshotApply_RECOVER(uint32_t genctrl0, uint32_t nvmctrla) {
+    NVMCTRL_CTRLA_Type ctrla;
+    ctrla.reg = nvmctrla;
+    if (OSCCTRL->DFLLCTRLA.bit.ENABLE && OSCCTRL->STATUS.bit.DFLLRDY) {
+        fourRegsSnapshotApply_GEN(0, GCLK_GENCTRL_SRC(GCLK_GENCTRL_SRC_DFLL_Val) | GCLK_GENCTRL_GENEN,
+                fourRegsSnapshotApply_polls());
+        // the DFLL's 48 MHz needs at least one wait state
+        if (ctrla.bit.RWS < 1) {
+            ctrla.bit.RWS = 1;
+        }
+    } else {
+        fourRegsSnapshotApply_GEN(0, genctrl0, fourRegsSnapshotApply_polls());
+    }
+    NVMCTRL->CTRLA.reg = ctrla.reg;
+}
+
+bool fourRegsSnapshotApply(const FourRegsSnapshot &snap) {
+    // Writes to a peripheral which the PAC protects are dropped (and flag an
+    // error), so protection is lifted for the duration and then put back.
+    volatile uint32_t* status = &PAC->STATUSA.reg;
+    bool locked[FourRegsAPPLY_PERID_COUNT];
+    for (uint8_t i = 0; i < FourRegsAPPLY_PERID_COUNT; i++) {
+        uint8_t id = FourRegsAPPLY_PERIDs[i];
+        locked[i] = status[id / 32] & (1UL << (id % 32));
+        if (locked[i]) {
+            PAC->WRCTRL.reg = PAC_WRCTRL_PERID(id) | PAC_WRCTRL_KEY_CLR;
+        }
+    }
+    uint32_t genctrl0 = GCLK->GENCTRL[0].reg;
+    uint32_t nvmctrla = NVMCTRL->CTRLA.reg;
+    bool clocked = false;
+    bool ok = fourRegsSnapshotApply_STEPS(snap, clocked);
+    if (!ok && !clocked) {
+        fourRegsSnapshotApply_RECOVER(genctrl0, nvmctrla);
+    }
+    for (uint8_t i = 0; i < FourRegsAPPLY_PERID_COUNT; i++) {
+        if (locked[i]) {
+            PAC->WRCTRL.reg = PAC_WRCTRL_PERID(FourRegsAPPLY_PERIDs[i]) | PAC_WRCTRL_KEY_SET;
+        }
+    }
+    return ok;
+}
+
+
+// states of FourRegsFormatter, one per part of a line
+enum {
+    FourRegsFormatter_REGISTER,     // text up to the first ":"
+    FourRegsFormatter_HEADER,       // dashes at the start of a peripheral header
+    FourRegsFormatter_NAME,         // peripheral name in the header
+    FourRegsFormatter_DETAIL,       // rest of the header
+    FourRegsFormatter_FIELDS,       // space-separated fields after the ":"
+};
+
+FourRegsFormatter::FourRegsFormatter(Print &out, uint8_t format) : out(out), format(format) {
+    state = FourRegsFormatter_REGISTER;
+    inPeripheral = false;
+    inRegister = false;
+    firstPeripheral = true;
+    firstRegister = true;
+    firstField = true;
+    hasRaw = false;
+    rawValue = 0;
+    peripheral[0] = '\0';
+    instance[0] = '\0';
+    detail[0] = '\0';
+    reg[0] = '\0';
+    token[0] = '\0';
+    bare[0] = '\0';
+    len = 0;
+}
+
+void FourRegsFormatter::begin() {
+    if (format == FOUR_REGS_JSON) {
+        out.print("{\"fourregs\":[");
+    }
+    if (format == FOUR_REGS_CSV) {
+        out.println("peripheral,instance,register,field,raw,decoded");
+    }
+}
+
+void FourRegsFormatter::raw(uint32_t value) {
+    rawValue = value;
+    hasRaw = true;
+}
+
+// adds a character to a buffer, marking the end with "~" if it doesn't fit
+void FourRegsFormatter::append(char* buf, uint8_t size, char c) {
+    if (len < size - 1) {
+        buf[len++] = c;
+    } else {
+        buf[size - 2] = '~';
+    }
+}
+
+void FourRegsFormatter::end() {
+    if (len || state != FourRegsFormatter_REGISTER) {
+        // finish an unterminated line
+        write('\n');
+    }
+    endPeripheral();
+    if (format == FOUR_REGS_JSON) {
+        out.println("\n]}");
+    }
+}
+
+size_t FourRegsFormatter::write(uint8_t c) {
+    if (c == '\r') {
+        return 1;
+    }
+    switch (state) {
+        case FourRegsFormatter_REGISTER:
+            if (c == '\n' || c == ':') {
+                while (len && reg[len - 1] == ' ') {
+                    len--;
+                }
+                reg[len] = '\0';
+                len = 0;
+                if (c == ':') {
+                    startRegister();
+                    state = FourRegsFormatter_FIELDS;
+                } else if (reg[0]) {
+                    // line without a register, such as "--disabled--"
+                    note();
+                }
+                return 1;
+            }
+            if (c == ' ' && len == 0) {
+                // indentation
+                return 1;
+            }
+            append(reg, sizeof(reg), c);
+            if (len == 3 && 0 == strncmp(reg, "---", 3)) {
+                state = FourRegsFormatter_HEADER;
+                len = 0;
+            }
+            return 1;
+
+        case FourRegsFormatter_HEADER:
+            if (c == '-') {
+                return 1;
+            }
+            state = FourRegsFormatter_NAME;
+            if (c == ' ') {
+                return 1;
+            }
+            // fall through
+        case FourRegsFormatter_NAME:
+        case FourRegsFormatter_DETAIL:
+            if (c != '\n') {
+                if (state == FourRegsFormatter_NAME) {
+                    if (c == ' ') {
+                        peripheral[len] = '\0';
+                        state = FourRegsFormatter_DETAIL;
+                        len = 0;
+                    } else {
+                        append(peripheral, sizeof(peripheral), c);
+                    }
+                } else if (c != ' ' || len) {
+                    append(detail, sizeof(detail), c);
+                }
+                return 1;
+            }
+            if (state == FourRegsFormatter_NAME) {
+                peripheral[len] = '\0';
+                len = 0;
+            }
+            detail[len] = '\0';
+            len = 0;
+            // "SERCOM2" is peripheral "SERCOM" instance "2"
+            while (len < sizeof(instance) - 1) {
+                uint8_t plen = strlen(peripheral);
+                if (plen < 2 || peripheral[plen - 1] < '0' || peripheral[plen - 1] > '9') {
+                    break;
+                }
+                memmove(instance + 1, instance, len);
+                instance[0] = peripheral[plen - 1];
+                peripheral[plen - 1] = '\0';
+                len++;
+            }
+            instance[len] = '\0';
+            // "PORT A" is peripheral "PORT" instance "A"
+            if (len == 0 && detail[0] && detail[1] == '\0') {
+                instance[0] = detail[0];
+                instance[1] = '\0';
+                detail[0] = '\0';
+            }
+            len = 0;
+            startPeripheral();
+            state = FourRegsFormatter_REGISTER;
+            return 1;
+
+        case FourRegsFormatter_FIELDS:
+            if (c == ' ' || c == '\n') {
+                if (len) {
+                    token[len] = '\0';
+                    field();
+                    len = 0;
+                }
+                if (c == '\n') {
+                    endRegister();
+                    state = FourRegsFormatter_REGISTER;
+                }
+                return 1;
+            }
+            append(token, sizeof(token), c);
+            return 1;
+    }
+    return 1;
+}
+
+void FourRegsFormatter::startPeripheral() {
+    endPeripheral();
+    if (format == FOUR_REGS_JSON) {
+        if (!firstPeripheral) {
+            out.print(",");
+        }
+        out.print("\n{\"peripheral\":");
+        quoted(peripheral);
+        out.print(",\"instance\":");
+        quoted(instance);
+        out.print(",\"detail\":");
+        quoted(detail);
+        out.print(",\"registers\":[");
+    }
+    if (format == FOUR_REGS_CSV && detail[0]) {
+        reg[0] = '\0';
+        row("detail", detail);
+    }
+    inPeripheral = true;
+    firstPeripheral = false;
+    firstRegister = true;
+}
+
+void FourRegsFormatter::startRegister() {
+    if (!inPeripheral) {
+        peripheral[0] = '\0';
+        instance[0] = '\0';
+        detail[0] = '\0';
+        startPeripheral();
+    }
+    if (format == FOUR_REGS_JSON) {
+        if (!firstRegister) {
+            out.print(",");
+        }
+        out.print("\n{\"register\":");
+        quoted(reg);
+        if (hasRaw) {
+            out.print(",\"raw\":\"0x");
+            out.print(rawValue, HEX);
+            out.print("\"");
+        }
+        out.print(",\"fields\":[");
+    }
+    inRegister = true;
+    firstRegister = false;
+    firstField = true;
+}
+
+// Fields are "name=value", or a flag (a bare upper-case word such as "IDC")
+// which is keyed by its own name.  Any other words (the value of a register
+// such as "PER:  150", or a list such as "irq pri2:  SERCOM0:2 USB:0") are
+// collected and written at the end of the line keyed by the register name,
+// so every field on a line has a key of its own.
+void FourRegsFormatter::field() {
+    char* value = strchr(token, '=');
+    if (value) {
+        *value++ = '\0';
+    }
+    bool flag = !value && isupper(token[0]);
+    for (const char* t = token; flag && *t; t++) {
+        flag = isupper(*t) || isdigit(*t) || *t == '_';
+    }
+    if (!value && !flag) {
+        uint8_t blen = strlen(bare);
+        uint8_t tlen = strlen(token);
+        if (blen && blen < sizeof(bare) - 1) {
+            bare[blen++] = ' ';
+        }
+        if (blen + tlen < sizeof(bare)) {
+            strcpy(bare + blen, token);
+        } else if (blen < sizeof(bare) - 1) {
+            strncpy(bare + blen, token, sizeof(bare) - 1 - blen);
+            bare[sizeof(bare) - 2] = '~';
+            bare[sizeof(bare) - 1] = '\0';
+        }
+        return;
+    }
+    namedField(token, value);
+}
+
+// a flag has no value
+void FourRegsFormatter::namedField(const char* name, const char* value) {
+    if (format == FOUR_REGS_JSON) {
+        if (!firstField) {
+            out.print(",");
+        }
+        out.print("{\"field\":");
+        quoted(name);
+        out.print(",\"value\":");
+        if (value) {
+            quoted(value);
+        } else {
+            out.print("true");
+        }
+        out.print("}");
+    }
+    if (format == FOUR_REGS_CSV) {
+        row(name, value ? value : "1");
+    }
+    firstField = false;
+}
+
+// a line without a register, such as "--disabled--"
+void FourRegsFormatter::note() {
+    if (!inPeripheral) {
+        peripheral[0] = '\0';
+        instance[0] = '\0';
+        detail[0] = '\0';
+        startPeripheral();
+    }
+    endRegister();
+    if (format == FOUR_REGS_JSON) {
+        if (!firstRegister) {
+            out.print(",");
+        }
+        out.print("\n{\"note\":");
+        quoted(reg);
+        out.print("}");
+    }
+    if (format == FOUR_REGS_CSV) {
+        strcpy(token, reg);
+        reg[0] = '\0';
+        row("note", token);
+    }
+    reg[0] = '\0';
+    hasRaw = false;
+    firstRegister = false;
+}
+
+void FourRegsFormatter::endRegister() {
+    if (!inRegister) {
+        return;
+    }
+    if (bare[0]) {
+        namedField(reg, bare);
+        bare[0] = '\0';
+    }
+    if (format == FOUR_REGS_JSON) {
+        out.print("]}");
+    }
+    inRegister = false;
+    hasRaw = false;
+}
+
+void FourRegsFormatter::endPeripheral() {
+    endRegister();
+    if (!inPeripheral) {
+        return;
+    }
+    if (format == FOUR_REGS_JSON) {
+        out.print("]}");
+    }
+    inPeripheral = false;
+}
+
+void FourRegsFormatter::quoted(const char* str) {
+    out.print("\"");
+    for (; *str; str++) {
+        if (*str == '"' || *str == '\\') {
+            out.print("\\");
+        }
+        if ((uint8_t) *str < 0x20) {
+            // control characters
+            out.print("\\u00");
+            out.print((*str >> 4) & 0xF, HEX);
+            out.print(*str & 0xF, HEX);
+            continue;
+        }
+        out.print(*str);
+    }
+    out.print("\"");
+}
+
+// The "raw" column has the value of the whole register (when the printer
+// passed it), and the "decoded" column the field as the text shows it.
+void FourRegsFormatter::row(const char* name, const char* value) {
+    csv(peripheral);
+    out.print(",");
+    csv(instance);
+    out.print(",");
+    csv(reg);
+    out.print(",");
+    csv(name);
+    out.print(",");
+    if (hasRaw) {
+        out.print("0x");
+        out.print(rawValue, HEX);
+    }
+    out.print(",");
+    csv(value);
+    out.println();
+}
+
+void FourRegsFormatter::csv(const char* str) {
+    if (!strpbrk(str, ",\"\n")) {
+        out.print(str);
+        return;
+    }
+    out.print("\"");
+    for (; *str; str++) {
+        if (*str == '"') {
+            out.print("\"");
+        }
+        out.print(*str);
+    }
+    out.print("\"");
+}
+
+
+void printFourRegs(FourRegOptions &opts) {
+    printFourRegs<FOUR_REGS_ALL>(opts);
 }
 
 
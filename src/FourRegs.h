@@ -31,27 +31,88 @@ SOFTWARE.
 #include <Arduino.h>
 
 
+class FourRegsFormatter;
+
 // This is a wild experiment in API design. The idea is to make it easy to add
 // new configuration options in the future without a long list of arguments.
 struct FourRegOptions {
     Print   &print;
     bool    showDisabled;
+    uint8_t format;         // one of FOUR_REGS_TEXT (default), FOUR_REGS_JSON, or FOUR_REGS_CSV
+    FourRegsFormatter* formatter;   // set by printFourRegs<>() while formatting, so printers can pass raw register values
+};
+
+// Values for FourRegOptions::format.
+#define FOUR_REGS_TEXT  0
+#define FOUR_REGS_JSON  1
+#define FOUR_REGS_CSV   2
+
+
+// Rewrites the text from the printers into another format as it streams
+// through.  Only the names from the current line are kept in memory, in the
+// fixed buffers below.  They are sized for the longest register and field
+// names the printers use; only values too long for them are cut short and
+// end with "~".  Only printFourRegs() formats; the printFourRegXXX()
+// functions called directly always print text.
+class FourRegsFormatter : public Print {
+    public:
+        FourRegsFormatter(Print &out, uint8_t format);
+        void begin();
+        void end();
+        void raw(uint32_t value);   // raw value of the register on the next line
+        virtual size_t write(uint8_t c);
+        using Print::write;
+
+    private:
+        void startPeripheral();
+        void startRegister();
+        void field();
+        void namedField(const char* name, const char* value);
+        void note();
+        void endRegister();
+        void endPeripheral();
+        void quoted(const char* str);
+        void row(const char* name, const char* value);
+        void csv(const char* str);
+        void append(char* buf, uint8_t size, char c);
+
+        Print   &out;
+        uint8_t format;
+        uint8_t state;
+        bool    inPeripheral;
+        bool    inRegister;
+        bool    firstPeripheral;
+        bool    firstRegister;
+        bool    firstField;
+        bool    hasRaw;
+        uint32_t rawValue;
+        char    peripheral[16];
+        char    instance[4];
+        char    detail[40];
+        char    reg[32];
+        char    token[64];
+        char    bare[64];
+        uint8_t len;
 };
 
 
 void printFourRegAC(FourRegOptions &opts);
 void printFourRegADC(FourRegOptions &opts, Adc* adc, uint8_t idx);
 void printFourRegAES(FourRegOptions &opts);
-//FUTURE void printFourRegCAN(FourRegOptions &opts);
+#ifdef CAN0
+void printFourRegCAN(FourRegOptions &opts, Can* can, uint8_t idx);
+#endif
 void printFourRegCCL(FourRegOptions &opts);
 void printFourRegCMCC(FourRegOptions &opts);
 void printFourRegDAC(FourRegOptions &opts);
 void printFourRegDMAC(FourRegOptions &opts);
-//FUTURE void printFourRegDSU(FourRegOptions &opts);
+void printFourRegDSU(FourRegOptions &opts);
 void printFourRegEIC(FourRegOptions &opts);
 void printFourRegEVSYS(FourRegOptions &opts);
+void printFourRegEVSYSGraph(FourRegOptions &opts);
 void printFourRegFREQM(FourRegOptions &opts);
 void printFourRegGCLK(FourRegOptions &opts);
+void printFourRegHMATRIX(FourRegOptions &opts);
 #ifdef I2S
 void printFourRegI2S(FourRegOptions &opts);
 #endif
@@ -65,9 +126,15 @@ void printFourRegPCC(FourRegOptions &opts);
 void printFourRegPDEC(FourRegOptions &opts);
 void printFourRegPM(FourRegOptions &opts);
 void printFourRegPORT(FourRegOptions &opts);
+void printFourRegPORTMatrix(FourRegOptions &opts);
 void printFourRegQSPI(FourRegOptions &opts);
+void printFourRegRAMECC(FourRegOptions &opts);
+void printFourRegRSTC(FourRegOptions &opts);
 void printFourRegRTC(FourRegOptions &opts);
 void printFourRegSCS(FourRegOptions &opts);
+#ifdef SDHC0
+void printFourRegSDHC(FourRegOptions &opts, Sdhc* sdhc, uint8_t idx);
+#endif
 void printFourRegSERCOM(FourRegOptions &opts, Sercom* sercom, uint8_t idx);
 void printFourRegSUPC(FourRegOptions &opts);
 void printFourRegTC(FourRegOptions &opts, Tc* tc, uint8_t idx);
@@ -78,4 +145,274 @@ void printFourRegWDT(FourRegOptions &opts);
 
 void printFourRegs(FourRegOptions &opts);
 
+
+// Bits for choosing which peripherals printFourRegs<>() shows.
+#define FOUR_REGS_AC            (1ULL << 0)
+#define FOUR_REGS_ADC           (1ULL << 1)
+#define FOUR_REGS_AES           (1ULL << 2)
+#define FOUR_REGS_CCL           (1ULL << 3)
+#define FOUR_REGS_CMCC          (1ULL << 4)
+#define FOUR_REGS_DAC           (1ULL << 5)
+#define FOUR_REGS_DMAC          (1ULL << 6)
+#define FOUR_REGS_EIC           (1ULL << 7)
+#define FOUR_REGS_EVSYS         (1ULL << 8)
+#define FOUR_REGS_FREQM         (1ULL << 9)
+#define FOUR_REGS_GCLK          (1ULL << 10)
+#define FOUR_REGS_I2S           (1ULL << 11)
+#define FOUR_REGS_ICM           (1ULL << 12)
+#define FOUR_REGS_MCLK          (1ULL << 13)
+#define FOUR_REGS_NVMCTRL       (1ULL << 14)
+#define FOUR_REGS_OSC32KCTRL    (1ULL << 15)
+#define FOUR_REGS_OSCCTRL       (1ULL << 16)
+#define FOUR_REGS_PAC           (1ULL << 17)
+#define FOUR_REGS_PCC           (1ULL << 18)
+#define FOUR_REGS_PDEC          (1ULL << 19)
+#define FOUR_REGS_PM            (1ULL << 20)
+#define FOUR_REGS_PORT          (1ULL << 21)
+#define FOUR_REGS_QSPI          (1ULL << 22)
+#define FOUR_REGS_RTC           (1ULL << 23)
+#define FOUR_REGS_SCS           (1ULL << 24)
+#define FOUR_REGS_SERCOM        (1ULL << 25)
+#define FOUR_REGS_SUPC          (1ULL << 26)
+#define FOUR_REGS_TC            (1ULL << 27)
+#define FOUR_REGS_TCC           (1ULL << 28)
+#define FOUR_REGS_TRNG          (1ULL << 29)
+#define FOUR_REGS_USB           (1ULL << 30)
+#define FOUR_REGS_WDT           (1ULL << 31)
+#define FOUR_REGS_CAN           (1ULL << 32)
+#define FOUR_REGS_DSU           (1ULL << 33)
+#define FOUR_REGS_SDHC          (1ULL << 34)
+#define FOUR_REGS_RSTC          (1ULL << 35)
+#define FOUR_REGS_RAMECC        (1ULL << 36)
+#define FOUR_REGS_HMATRIX       (1ULL << 37)
+#define FOUR_REGS_ALL           (~0ULL)
+
+
+// Hash of the configuration registers of the selected peripherals.  Status
+// and counter registers aren't included, so boards configured the same way
+// have the same fingerprint.
+uint32_t fourRegsFingerprint(uint64_t peripherals = FOUR_REGS_ALL);
+void printFourRegsFingerprint(FourRegOptions &opts);
+
+
+// Keeps a history of the last few resets in backup RAM, which
+// printFourRegRSTC() shows.  Call fourRegsResetHistoryRecord() once early in
+// setup(), and fourRegsResetHistoryUpdate() every so often from loop() to
+// keep the uptime and fingerprint of the current run up to date.
+void fourRegsResetHistoryRecord();
+void fourRegsResetHistoryUpdate();
+
+
+// Counts RAM ECC errors.  Call fourRegsRAMECCPoll() often, such as from loop()
+// or RAMECC_Handler(), since only one error of each kind is seen per poll.
+// fourRegsRAMECCTake() returns the counts since it was last called.
+struct FourRegsRAMECCCounts {
+    uint32_t single;        // corrected single-bit errors
+    uint32_t dual;          // uncorrectable double-bit errors
+    uint32_t ms;            // length of the interval
+};
+void fourRegsRAMECCPoll();
+void fourRegsRAMECCTake(FourRegsRAMECCCounts &counts);
+
+
+// Profiles the peripheral interrupts.  fourRegsIRQProfileStart() moves the
+// vector table to SRAM and routes every IRQ through a handler which counts it
+// and times it with the DWT cycle counter.  printFourRegIRQProfile() shows the
+// rate and CPU load of each IRQ since the start.
+void fourRegsIRQProfileStart();
+void fourRegsIRQProfileStop();
+void printFourRegIRQProfile(FourRegOptions &opts);
+
+
+// A compact copy of the clock, MCLK, PORT, and SERCOM configuration, small
+// enough to keep in backup RAM or SmartEEPROM.  fourRegsSnapshotCapture() only
+// reads registers, so it can be called from a fault handler.
+struct FourRegsSnapshot {
+    uint32_t millis;            // millis() at the capture
+    // OSC32KCTRL
+    uint32_t osculp32k;
+    uint16_t xosc32k;
+    uint8_t  rtcctrl;
+    uint8_t  cfdctrl;
+    // OSCCTRL
+    uint32_t xoscctrl[2];
+    uint8_t  dfllctrla;
+    uint8_t  dfllctrlb;
+    uint8_t  dpllctrla[2];
+    uint32_t dfllval;
+    uint32_t dfllmul;
+    uint32_t dpllratio[2];
+    uint32_t dpllctrlb[2];
+    // GCLK
+    uint32_t genctrl[12];
+    uint8_t  pchctrl[48];
+    // MCLK and NVMCTRL
+    uint8_t  cpudiv;
+    uint8_t  reserved;
+    uint16_t nvmctrla;          // for the flash wait states
+    uint32_t ahbmask;
+    uint32_t apbmask[4];        // APBAMASK through APBDMASK
+    // PORT
+    uint32_t dir[4];
+    uint32_t out[4];
+    uint8_t  pincfg[4][32];
+    uint8_t  pmux[4][16];
+    // SERCOM CTRLA, CTRLB, CTRLC, and BAUD as 32-bit words whatever the mode
+    uint32_t sercom[8][4];
+};
+void fourRegsSnapshotCapture(FourRegsSnapshot &snap);
+void printFourRegsSnapshot(FourRegOptions &opts, const FourRegsSnapshot &snap);
+
+
+// Records crashes.  fourRegsCrashHookInstall() points the HardFault,
+// MemManage, BusFault, and UsageFault vectors at a handler which saves the
+// exception frame, the fault status registers, and a snapshot to backup RAM
+// (after the reset history) and then resets.  printFourRegsCrash() shows the
+// record on the next boot, until fourRegsCrashClear() is called.
+void fourRegsCrashHookInstall();
+void fourRegsCrashClear();
+void printFourRegsCrash(FourRegOptions &opts);
+
+
+// Keeps a log of snapshots in a ring in the SmartEEPROM (which has to be set
+// up with the SBLK and PSZ fuses).  Each entry has a sequence number and a
+// CRC.  fourRegsSnapshotLogAppend() returns false if the SmartEEPROM isn't
+// set up, is locked, or stays busy.  fourRegsSnapshotLogRead() reads the
+// entry AGE back from the newest (0 is the newest).
+bool fourRegsSnapshotLogAppend(const FourRegsSnapshot &snap);
+uint16_t fourRegsSnapshotLogCount();
+bool fourRegsSnapshotLogRead(uint16_t age, FourRegsSnapshot &snap, uint32_t* sequence = NULL);
+void printFourRegsSnapshotLog(FourRegOptions &opts);
+
+
+// Writes a snapshot back to the hardware in dependency order: the CPU moves
+// to the DFLL, then oscillators, generators and the DFLL/DPLLs (waiting for
+// each to be ready or locked), then the CPU clock and flash wait states,
+// peripheral channels, MCLK masks, pins, and lastly the SERCOMs.  The SERCOMs
+// are the only peripherals restored; the others aren't in the snapshot.
+// Registers which already match are left alone.  Returns false if something
+// didn't become ready in time, in which case the rest isn't written.  If
+// that happens before GEN0 has its final source, the CPU is put back on a
+// running clock with its flash wait states restored.
+bool fourRegsSnapshotApply(const FourRegsSnapshot &snap);
+
+
+// Like printFourRegs() but only shows the peripherals selected in PERIPHERALS.
+// The printers which aren't selected are never referenced, so the linker drops
+// them (and their name tables) from the firmware.
+template <uint64_t PERIPHERALS>
+void printFourRegs(FourRegOptions &opts) {
+    if (opts.format != FOUR_REGS_TEXT) {
+        FourRegsFormatter formatter(opts.print, opts.format);
+        FourRegOptions textOpts = { formatter, opts.showDisabled, FOUR_REGS_TEXT, &formatter };
+        formatter.begin();
+        printFourRegs<PERIPHERALS>(textOpts);
+        formatter.end();
+        return;
+    }
+
+    // show system basics
+    if (PERIPHERALS & FOUR_REGS_SCS)        { printFourRegSCS(opts); }
+    if (PERIPHERALS & FOUR_REGS_OSCCTRL)    { printFourRegOSCCTRL(opts); }
+    if (PERIPHERALS & FOUR_REGS_OSC32KCTRL) { printFourRegOSC32KCTRL(opts); }
+    if (PERIPHERALS & FOUR_REGS_GCLK)       { printFourRegGCLK(opts); }
+    if (PERIPHERALS & FOUR_REGS_MCLK)       { printFourRegMCLK(opts); }
+    if (PERIPHERALS & FOUR_REGS_RTC)        { printFourRegRTC(opts); }
+
+    // show core peripherals
+    if (PERIPHERALS & FOUR_REGS_CMCC)       { printFourRegCMCC(opts); }
+    if (PERIPHERALS & FOUR_REGS_DSU)        { printFourRegDSU(opts); }
+    if (PERIPHERALS & FOUR_REGS_DMAC)       { printFourRegDMAC(opts); }
+    if (PERIPHERALS & FOUR_REGS_HMATRIX)    { printFourRegHMATRIX(opts); }
+    if (PERIPHERALS & FOUR_REGS_EVSYS)      { printFourRegEVSYS(opts); }
+    if (PERIPHERALS & FOUR_REGS_PAC)        { printFourRegPAC(opts); }
+    if (PERIPHERALS & FOUR_REGS_PM)         { printFourRegPM(opts); }
+    if (PERIPHERALS & FOUR_REGS_RAMECC)     { printFourRegRAMECC(opts); }
+    if (PERIPHERALS & FOUR_REGS_RSTC)       { printFourRegRSTC(opts); }
+    if (PERIPHERALS & FOUR_REGS_SUPC)       { printFourRegSUPC(opts); }
+    if (PERIPHERALS & FOUR_REGS_WDT)        { printFourRegWDT(opts); }
+
+    // show other peripherals
+    if (PERIPHERALS & FOUR_REGS_AC)         { printFourRegAC(opts); }
+    if (PERIPHERALS & FOUR_REGS_ADC) {
+        printFourRegADC(opts, ADC0, 0);
+        printFourRegADC(opts, ADC1, 1);
+    }
+    if (PERIPHERALS & FOUR_REGS_AES)        { printFourRegAES(opts); }
+#ifdef CAN0
+    if (PERIPHERALS & FOUR_REGS_CAN) {
+        printFourRegCAN(opts, CAN0, 0);
+#ifdef CAN1
+        printFourRegCAN(opts, CAN1, 1);
+#endif
+    }
+#endif
+    if (PERIPHERALS & FOUR_REGS_CCL)        { printFourRegCCL(opts); }
+    if (PERIPHERALS & FOUR_REGS_DAC)        { printFourRegDAC(opts); }
+    if (PERIPHERALS & FOUR_REGS_EIC)        { printFourRegEIC(opts); }
+    if (PERIPHERALS & FOUR_REGS_FREQM)      { printFourRegFREQM(opts); }
+#ifdef I2S
+    if (PERIPHERALS & FOUR_REGS_I2S)        { printFourRegI2S(opts); }
+#endif
+    if (PERIPHERALS & FOUR_REGS_ICM)        { printFourRegICM(opts); }
+    if (PERIPHERALS & FOUR_REGS_NVMCTRL)    { printFourRegNVMCTRL(opts); }
+    if (PERIPHERALS & FOUR_REGS_PCC)        { printFourRegPCC(opts); }
+    if (PERIPHERALS & FOUR_REGS_PDEC)       { printFourRegPDEC(opts); }
+    if (PERIPHERALS & FOUR_REGS_PORT)       { printFourRegPORT(opts); }
+    if (PERIPHERALS & FOUR_REGS_QSPI)       { printFourRegQSPI(opts); }
+#ifdef SDHC0
+    if (PERIPHERALS & FOUR_REGS_SDHC) {
+        printFourRegSDHC(opts, SDHC0, 0);
+#ifdef SDHC1
+        printFourRegSDHC(opts, SDHC1, 1);
+#endif
+    }
+#endif
+    if (PERIPHERALS & FOUR_REGS_SERCOM) {
+        printFourRegSERCOM(opts, SERCOM0, 0);
+        printFourRegSERCOM(opts, SERCOM1, 1);
+        printFourRegSERCOM(opts, SERCOM2, 2);
+        printFourRegSERCOM(opts, SERCOM3, 3);
+        printFourRegSERCOM(opts, SERCOM4, 4);
+        printFourRegSERCOM(opts, SERCOM5, 5);
+#ifdef SERCOM6
+        printFourRegSERCOM(opts, SERCOM6, 6);
+#endif
+#ifdef SERCOM7
+        printFourRegSERCOM(opts, SERCOM7, 7);
+#endif
+    }
+    if (PERIPHERALS & FOUR_REGS_TCC) {
+        printFourRegTCC(opts, TCC0, 0);
+        printFourRegTCC(opts, TCC1, 1);
+        printFourRegTCC(opts, TCC2, 2);
+#ifdef TCC3
+        printFourRegTCC(opts, TCC3, 3);
+#endif
+#ifdef TCC4
+        printFourRegTCC(opts, TCC4, 4);
+#endif
+    }
+    if (PERIPHERALS & FOUR_REGS_TC) {
+        printFourRegTC(opts, TC0, 0);
+        printFourRegTC(opts, TC1, 1);
+        printFourRegTC(opts, TC2, 2);
+        printFourRegTC(opts, TC3, 3);
+#ifdef TC4
+        printFourRegTC(opts, TC4, 4);
+#endif
+#ifdef TC5
+        printFourRegTC(opts, TC5, 5);
+#endif
+#ifdef TC6
+        printFourRegTC(opts, TC6, 6);
+#endif
+#ifdef TC7
+        printFourRegTC(opts, TC7, 7);
+#endif
+    }
+    if (PERIPHERALS & FOUR_REGS_TRNG)       { printFourRegTRNG(opts); }
+    if (PERIPHERALS & FOUR_REGS_USB)        { printFourRegUSB(opts); }
+}
+
 #endif // FOUR_REGS_H